@@ -32,6 +32,30 @@ typedef struct mx25519_pubkey {
     uint8_t data[32];
 } mx25519_pubkey;
 
+/*
+ * Curve25519 point in affine coordinates (u, v).
+ */
+typedef struct mx25519_point {
+    uint8_t u[32];
+    uint8_t v[32];
+} mx25519_point;
+
+/*
+ * X25519 X-coordinate in projective form (X:Z), before the final field
+ * inversion. The contents are internal and should not be inspected.
+ */
+typedef struct mx25519_projective {
+    uint8_t data[64];
+} mx25519_projective;
+
+/*
+ * State of a resumable scalar multiplication. Allocated by the caller,
+ * the contents are private.
+ */
+typedef struct mx25519_scmul_ctx {
+    uint64_t opaque[32];
+} mx25519_scmul_ctx;
+
 /*
  * Opaque struct holding a scalar multiplication implementation.
  */
@@ -46,8 +70,35 @@ typedef enum mx25519_type {
     MX25519_TYPE_ARM64,     /* ARM64 assembly */
     MX25519_TYPE_AMD64,     /* AMD64 assembly */
     MX25519_TYPE_AMD64X,    /* AMD64 assembly with MULX+ADX */
+    MX25519_TYPE_ARM64_MUL64, /* ARM64 with 64-bit limbs */
+    MX25519_TYPE_AMD64_MULX, /* AMD64 assembly with MULX, without ADX */
+    MX25519_TYPE_AMD64X_COMPACT, /* size-optimized AMD64X, never AUTO */
+    MX25519_TYPE_ARM64_SVE2, /* ARM64 with SVE2, multi-lane batches, never AUTO */
+    MX25519_TYPE_COUNT      /* number of implementation types */
 } mx25519_type;
 
+/*
+ * The implementation type of a library built with MX25519_FORCE_IMPL_<TYPE>.
+ * Undefined if the implementation is selected at runtime.
+ */
+#if defined(MX25519_FORCE_IMPL_PORTABLE)
+#define MX25519_FORCE_IMPL MX25519_TYPE_PORTABLE
+#elif defined(MX25519_FORCE_IMPL_ARM64)
+#define MX25519_FORCE_IMPL MX25519_TYPE_ARM64
+#elif defined(MX25519_FORCE_IMPL_AMD64)
+#define MX25519_FORCE_IMPL MX25519_TYPE_AMD64
+#elif defined(MX25519_FORCE_IMPL_AMD64X)
+#define MX25519_FORCE_IMPL MX25519_TYPE_AMD64X
+#elif defined(MX25519_FORCE_IMPL_ARM64_MUL64)
+#define MX25519_FORCE_IMPL MX25519_TYPE_ARM64_MUL64
+#elif defined(MX25519_FORCE_IMPL_AMD64_MULX)
+#define MX25519_FORCE_IMPL MX25519_TYPE_AMD64_MULX
+#elif defined(MX25519_FORCE_IMPL_AMD64X_COMPACT)
+#define MX25519_FORCE_IMPL MX25519_TYPE_AMD64X_COMPACT
+#elif defined(MX25519_FORCE_IMPL_ARM64_SVE2)
+#define MX25519_FORCE_IMPL MX25519_TYPE_ARM64_SVE2
+#endif
+
 /*
  * Private key unclamp types.
  *
@@ -63,6 +114,40 @@ typedef enum mx25519_unclamp_flags {
     MX25519_UNCLAMP_ALL  = MX25519_UNCLAMP_LSBS | MX25519_UNCLAMP_254
 } mx25519_unclamp_flags;
 
+/*
+ * Operation kinds counted by the statistics.
+ */
+typedef enum mx25519_op {
+    MX25519_OP_BASE,           /* mx25519_scmul_base */
+    MX25519_OP_BASE_UNCLAMPED, /* mx25519_scmul_base_unclamped */
+    MX25519_OP_KEY,            /* mx25519_scmul_key */
+    MX25519_OP_KEY_UNCLAMPED,  /* mx25519_scmul_key_unclamped */
+    MX25519_OP_BASE_FULL,      /* mx25519_scmul_base_full */
+    MX25519_OP_KEY_FULL,       /* mx25519_scmul_key_full */
+    MX25519_OP_KEY_BATCH,      /* mx25519_scmul_key_batch */
+    MX25519_OP_KEY_PROJECTIVE, /* mx25519_scmul_key_projective */
+    MX25519_OP_BASE_AND_KEY,   /* mx25519_scmul_base_and_key */
+    MX25519_OP_COUNT
+} mx25519_op;
+
+#define MX25519_STATS_TYPES MX25519_TYPE_COUNT /* indexed by mx25519_type */
+#define MX25519_STATS_BUCKETS 64 /* histogram buckets */
+
+/*
+ * Statistics of scalar multiplications done by the current process.
+ * Batch operations are counted once per key and the histogram records the
+ * average duration per key.
+ */
+typedef struct mx25519_stats {
+    /* number of scalar multiplications */
+    uint64_t count[MX25519_STATS_TYPES][MX25519_OP_COUNT];
+    /* sum of the durations in CPU timer ticks */
+    uint64_t ticks[MX25519_STATS_TYPES];
+    /* histogram[t][0] counts durations of 0 ticks and histogram[t][i]
+       for i > 0 counts durations in the range [2^(i-1), 2^i) */
+    uint64_t histogram[MX25519_STATS_TYPES][MX25519_STATS_BUCKETS];
+} mx25519_stats;
+
 #if defined(_WIN32) || defined(__CYGWIN__)
 #define MX25519_WIN
 #endif
@@ -102,6 +187,15 @@ extern "C" {
  */
 MX25519_API const mx25519_impl* mx25519_select_impl(mx25519_type type);
 
+#ifdef MX25519_FORCE_IMPL
+/*
+ * The only implementation of a library built with MX25519_FORCE_IMPL_<TYPE>.
+ * mx25519_select_impl returns it for MX25519_TYPE_AUTO and MX25519_FORCE_IMPL,
+ * on any machine.
+ */
+MX25519_API extern const mx25519_impl mx25519_impl_forced;
+#endif
+
 /*
  * @param impl is a pointer to an implementation. Must not be NULL.
  *
@@ -160,6 +254,240 @@ MX25519_API void mx25519_scmul_key_unclamped(const mx25519_impl* impl,
     mx25519_pubkey* result, const mx25519_privkey* key,
     const mx25519_pubkey* p, mx25519_unclamp_flags unclamp_flags);
 
+/*
+ * Calculates key*G, where G is the generator point of Curve25519. Unlike
+ * `mx25519_scmul_base()`, both coordinates of the result are calculated.
+ * The v-coordinate is recovered from the final state of the Montgomery ladder
+ * (Okeya-Sakurai), which only costs a few multiplications and no additional
+ * inversion.
+ *
+ * @param impl is a pointer to an implementation. Must not be NULL.
+ * @param result is the pointer where the resulting point will be stored.
+ *        Must not be NULL.
+ * @param key is a pointer to the private key. Must not be NULL.
+ */
+MX25519_API void mx25519_scmul_base_full(const mx25519_impl* impl,
+    mx25519_point* result, const mx25519_privkey* key);
+
+/*
+ * Calculates key*P, where P is a given point. Unlike `mx25519_scmul_key()`,
+ * both coordinates of P are needed and both coordinates of the result are
+ * calculated. If the result is the point at infinity, both coordinates are
+ * set to 0.
+ *
+ * @param impl is a pointer to an implementation. Must not be NULL.
+ * @param result is the pointer where the resulting point will be stored.
+ *        Must not be NULL.
+ * @param key is a pointer to the private key. Must not be NULL.
+ * @param p is a pointer to the point P. Must not be NULL. The point must be
+ *        on the curve.
+ */
+MX25519_API void mx25519_scmul_key_full(const mx25519_impl* impl,
+    mx25519_point* result, const mx25519_privkey* key,
+    const mx25519_point* p);
+
+/*
+ * Calculates both x(key*G) and x(key*P) for the same private key, e.g. an
+ * ephemeral public key and the corresponding shared secret. The results
+ * are identical to `mx25519_scmul_base()` and `mx25519_scmul_key()`, but
+ * the two final field inversions are shared.
+ *
+ * @param impl is a pointer to an implementation. Must not be NULL.
+ * @param pub is the pointer where x(key*G) will be stored. Must not be NULL.
+ * @param shared is the pointer where x(key*P) will be stored.
+ *        Must not be NULL.
+ * @param key is a pointer to the private key. Must not be NULL.
+ * @param p is a pointer to the base point P. Must not be NULL.
+ */
+MX25519_API void mx25519_scmul_base_and_key(const mx25519_impl* impl,
+    mx25519_pubkey* pub, mx25519_pubkey* shared, const mx25519_privkey* key,
+    const mx25519_pubkey* p);
+
+/*
+ * Calculates results[i] = x(keys[i]*points[i]) for i = 0 ... count-1.
+ * The results are identical to calling `mx25519_scmul_key()` for each entry,
+ * but the final field inversions are shared between up to 32 entries, which
+ * makes this function faster when many keys are processed at once.
+ *
+ * @param impl is a pointer to an implementation. Must not be NULL.
+ * @param results is the array where the resulting public keys will be
+ *        stored. Must not overlap with `keys` or `points`.
+ * @param keys is the array of private keys.
+ * @param points is the array of base points.
+ * @param count is the number of entries. All arrays must have at least
+ *        `count` elements. If `count` is zero, the arrays are not accessed.
+ */
+MX25519_API void mx25519_scmul_key_batch(const mx25519_impl* impl,
+    mx25519_pubkey* results, const mx25519_privkey* keys,
+    const mx25519_pubkey* points, size_t count);
+
+/*
+ * Like `mx25519_scmul_key()`, but skips the final field inversion. The
+ * result can be compared with `mx25519_projective_equals()` or converted
+ * to a public key with `mx25519_projective_normalize_batch()`.
+ *
+ * @param impl is a pointer to an implementation. Must not be NULL.
+ * @param result is the pointer where the projective result will be stored.
+ *        Must not be NULL.
+ * @param key is a pointer to the private key. Must not be NULL.
+ * @param p is a pointer to the base point P. Must not be NULL.
+ */
+MX25519_API void mx25519_scmul_key_projective(const mx25519_impl* impl,
+    mx25519_projective* result, const mx25519_privkey* key,
+    const mx25519_pubkey* p);
+
+/*
+ * Checks in constant time if a projective X-coordinate normalizes to the
+ * given public key, without a field inversion. The result is the same as
+ * normalizing `xz` and comparing all 32 bytes with `u`.
+ *
+ * @param u is a pointer to the public key. Must not be NULL.
+ * @param xz is a pointer to the projective X-coordinate. Must not be NULL.
+ *
+ * @return 1 if the values are equal, otherwise 0.
+ */
+MX25519_API int mx25519_projective_equals(const mx25519_pubkey* u,
+    const mx25519_projective* xz);
+
+/*
+ * Converts projective X-coordinates to public keys. One field inversion
+ * is shared between up to 32 entries. The results are identical to
+ * `mx25519_scmul_key()`.
+ *
+ * @param results is the array where the public keys will be stored.
+ * @param points is the array of projective X-coordinates.
+ * @param count is the number of entries. Both arrays must have at least
+ *        `count` elements.
+ */
+MX25519_API void mx25519_projective_normalize_batch(mx25519_pubkey* results,
+    const mx25519_projective* points, size_t count);
+
+/*
+ * Resumable calculation of x(key*P). The result is identical to
+ * `mx25519_scmul_key()`, but the work can be split into bounded chunks,
+ * e.g. to run it from an event loop or a coroutine without blocking for
+ * the whole scalar multiplication. The calculation has 255 ladder steps.
+ * Each step takes constant time and the private key is kept in the
+ * context until `mx25519_scmul_finish()` wipes it.
+ *
+ * This always uses the portable C ladder, with 64-bit limbs if the compiler
+ * supports 128-bit integers, whichever implementation is selected, so the
+ * total time can be longer than a single call with a faster implementation.
+ */
+
+/*
+ * Starts a resumable scalar multiplication.
+ *
+ * @param ctx is a pointer to the context to initialize. Must not be NULL.
+ * @param key is a pointer to the private key. Must not be NULL.
+ * @param p is a pointer to the base point P. Must not be NULL.
+ */
+MX25519_API void mx25519_scmul_begin(mx25519_scmul_ctx* ctx,
+    const mx25519_privkey* key, const mx25519_pubkey* p);
+
+/*
+ * Runs up to `nbits` ladder steps.
+ *
+ * @param ctx is a pointer to a context started by `mx25519_scmul_begin()`.
+ *        Must not be NULL.
+ * @param nbits is the maximum number of steps to run.
+ *
+ * @return the number of steps remaining. 0 means that the result is ready
+ *         to be retrieved with `mx25519_scmul_finish()`.
+ */
+MX25519_API unsigned mx25519_scmul_step(mx25519_scmul_ctx* ctx,
+    unsigned nbits);
+
+/*
+ * Runs the remaining ladder steps, if any, and stores the result. The
+ * context is wiped and must be started again before reuse.
+ *
+ * @param ctx is a pointer to a context started by `mx25519_scmul_begin()`.
+ *        Must not be NULL.
+ * @param result is the pointer where the result will be stored.
+ *        Must not be NULL.
+ */
+MX25519_API void mx25519_scmul_finish(mx25519_scmul_ctx* ctx,
+    mx25519_pubkey* result);
+
+/*
+ * Scalar arithmetic modulo the prime order of the base point
+ * l = 2^252 + 27742317777372353535851937790883648493. Scalars are stored
+ * in the `mx25519_privkey` struct as 32-byte little endian integers.
+ * Inputs may be any 256-bit values, results are always fully reduced
+ * (less than l). All scalar functions run in constant time.
+ *
+ * A reduced scalar is not a clamped private key. It must be used with
+ * `mx25519_scmul_base_unclamped()` or `mx25519_scmul_key_unclamped()`
+ * and `MX25519_UNCLAMP_ALL`.
+ */
+
+/*
+ * Calculates result = a*b mod l.
+ *
+ * @param result is the pointer where the result will be stored.
+ *        Must not be NULL. May be the same as `a` or `b`.
+ * @param a is a pointer to the first factor. Must not be NULL.
+ * @param b is a pointer to the second factor. Must not be NULL.
+ */
+MX25519_API void mx25519_scalar_mul(mx25519_privkey* result,
+    const mx25519_privkey* a, const mx25519_privkey* b);
+
+/*
+ * Calculates result = 1/a mod l. The inverse of zero is zero.
+ *
+ * @param result is the pointer where the result will be stored.
+ *        Must not be NULL. May be the same as `a`.
+ * @param a is a pointer to the scalar to invert. Must not be NULL.
+ */
+MX25519_API void mx25519_scalar_invert(mx25519_privkey* result,
+    const mx25519_privkey* a);
+
+/*
+ * Reduces a 512-bit little endian integer modulo l, e.g. the output of
+ * a 64-byte hash function.
+ *
+ * @param result is the pointer where the result will be stored.
+ *        Must not be NULL.
+ * @param data is a pointer to the 64-byte integer. Must not be NULL.
+ */
+MX25519_API void mx25519_scalar_reduce512(mx25519_privkey* result,
+    const uint8_t data[64]);
+
+/*
+ * Inverts scalars using a single modular exponentiation per 32 entries.
+ * The results are identical to `mx25519_scalar_invert()`, including zero
+ * entries, and the running time does not depend on which entries are zero.
+ *
+ * @param results is the array where the inverses will be stored. May be
+ *        the same as `scalars`, but must not partially overlap it.
+ * @param scalars is the array of scalars to invert.
+ * @param count is the number of entries. Both arrays must have at least
+ *        `count` elements.
+ */
+MX25519_API void mx25519_scalar_invert_batch(mx25519_privkey* results,
+    const mx25519_privkey* scalars, size_t count);
+
+/*
+ * Enables or disables statistics collection. It is disabled by default
+ * unless the library was built with MX25519_STATS. When enabled, every
+ * scalar multiplication reads the CPU timer twice and updates counters
+ * owned by the calling thread, so there is no contention between threads.
+ *
+ * @param enable is 1 to enable or 0 to disable statistics collection.
+ */
+MX25519_API void mx25519_stats_enable(int enable);
+
+/*
+ * Sums the statistics of all threads. Counters are never reset and they
+ * are kept after a thread exits. The snapshot is not atomic across
+ * counters.
+ *
+ * @param stats is the pointer where the statistics will be stored.
+ *        Must not be NULL.
+ */
+MX25519_API void mx25519_stats_snapshot(mx25519_stats* stats);
+
 #ifdef __cplusplus
 }
 #endif
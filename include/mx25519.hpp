@@ -0,0 +1,362 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+#ifndef MX25519_HPP
+#define MX25519_HPP
+
+/*
+ * Header-only C++20 interface. Requires linking with the mx25519 library.
+ * With libstdc++, the execution-policy overloads also require linking with
+ * TBB when its headers are installed.
+ */
+
+#include "mx25519.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <version>
+
+#if defined(__cpp_lib_execution) && __cpp_lib_execution >= 201603L
+#include <execution>
+#define MX25519_HAS_EXECUTION
+#endif
+
+namespace mx25519 {
+
+/*
+ * Implementation types, see `mx25519_type`.
+ */
+enum class type : int {
+    autodetect = MX25519_TYPE_AUTO,
+    portable = MX25519_TYPE_PORTABLE,
+    arm64 = MX25519_TYPE_ARM64,
+    amd64 = MX25519_TYPE_AMD64,
+    amd64x = MX25519_TYPE_AMD64X,
+    arm64_mul64 = MX25519_TYPE_ARM64_MUL64,
+    amd64_mulx = MX25519_TYPE_AMD64_MULX,
+    amd64x_compact = MX25519_TYPE_AMD64X_COMPACT,
+    arm64_sve2 = MX25519_TYPE_ARM64_SVE2,
+};
+
+/*
+ * Private key unclamp flags, see `mx25519_unclamp_flags`.
+ */
+enum class unclamp : int {
+    none = MX25519_UNCLAMP_NONE,
+    lsbs = MX25519_UNCLAMP_LSBS,
+    bit254 = MX25519_UNCLAMP_254,
+    all = MX25519_UNCLAMP_ALL,
+};
+
+/*
+ * Key types. They have the same layout as the C structs they derive from,
+ * so arrays of them are passed to the C API without copying.
+ */
+struct privkey : mx25519_privkey {
+    privkey() noexcept : mx25519_privkey{} {}
+    explicit privkey(std::span<const std::uint8_t, 32> bytes) noexcept {
+        std::memcpy(data, bytes.data(), sizeof(data));
+    }
+    std::span<std::uint8_t, 32> bytes() noexcept {
+        return data;
+    }
+    std::span<const std::uint8_t, 32> bytes() const noexcept {
+        return data;
+    }
+};
+
+struct pubkey : mx25519_pubkey {
+    pubkey() noexcept : mx25519_pubkey{} {}
+    explicit pubkey(std::span<const std::uint8_t, 32> bytes) noexcept {
+        std::memcpy(data, bytes.data(), sizeof(data));
+    }
+    std::span<std::uint8_t, 32> bytes() noexcept {
+        return data;
+    }
+    std::span<const std::uint8_t, 32> bytes() const noexcept {
+        return data;
+    }
+    friend bool operator==(const pubkey& a, const pubkey& b) noexcept {
+        return std::memcmp(a.data, b.data, sizeof(a.data)) == 0;
+    }
+};
+
+struct point : mx25519_point {
+    point() noexcept : mx25519_point{} {}
+    friend bool operator==(const point& a, const point& b) noexcept {
+        return std::memcmp(a.u, b.u, sizeof(a.u)) == 0
+            && std::memcmp(a.v, b.v, sizeof(a.v)) == 0;
+    }
+};
+
+static_assert(sizeof(privkey) == sizeof(mx25519_privkey));
+static_assert(sizeof(pubkey) == sizeof(mx25519_pubkey));
+static_assert(sizeof(point) == sizeof(mx25519_point));
+static_assert(std::is_trivially_copyable_v<privkey>);
+static_assert(std::is_trivially_copyable_v<pubkey>);
+
+namespace detail {
+
+/* number of keys processed by one task of the parallel batch functions */
+inline constexpr std::size_t parallel_chunk = 32;
+
+/* random access iterator over 0, 1, 2, ... used to split batches */
+class index_iterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::size_t*;
+    using reference = std::size_t;
+
+    index_iterator() noexcept = default;
+    explicit index_iterator(std::size_t i) noexcept : i_(i) {}
+
+    reference operator*() const noexcept { return i_; }
+    reference operator[](difference_type n) const noexcept { return i_ + n; }
+    index_iterator& operator++() noexcept { ++i_; return *this; }
+    index_iterator operator++(int) noexcept { return index_iterator(i_++); }
+    index_iterator& operator--() noexcept { --i_; return *this; }
+    index_iterator operator--(int) noexcept { return index_iterator(i_--); }
+    index_iterator& operator+=(difference_type n) noexcept { i_ += n; return *this; }
+    index_iterator& operator-=(difference_type n) noexcept { i_ -= n; return *this; }
+    friend index_iterator operator+(index_iterator a, difference_type n) noexcept { return a += n; }
+    friend index_iterator operator+(difference_type n, index_iterator a) noexcept { return a += n; }
+    friend index_iterator operator-(index_iterator a, difference_type n) noexcept { return a -= n; }
+    friend difference_type operator-(index_iterator a, index_iterator b) noexcept {
+        return static_cast<difference_type>(a.i_ - b.i_);
+    }
+    friend auto operator<=>(index_iterator a, index_iterator b) noexcept = default;
+
+private:
+    std::size_t i_ = 0;
+};
+
+#ifdef MX25519_HAS_EXECUTION
+/* the library functions may allocate and use atomics and thread-local storage */
+template<class Policy>
+concept supported_policy =
+    std::is_execution_policy_v<std::remove_cvref_t<Policy>> &&
+    !std::is_same_v<std::remove_cvref_t<Policy>,
+        std::execution::parallel_unsequenced_policy>
+#if __cpp_lib_execution >= 201902L
+    && !std::is_same_v<std::remove_cvref_t<Policy>,
+        std::execution::unsequenced_policy>
+#endif
+    ;
+#endif
+
+inline void check_batch(std::size_t results, std::size_t keys) {
+    if (results != keys) {
+        throw std::length_error("mx25519: batch size mismatch");
+    }
+}
+
+} // namespace detail
+
+/*
+ * Scalar multiplication bound to the implementation `Type`. The
+ * implementation is selected at runtime once per type and the kernels are
+ * called through the function pointers of `mx25519_impl`. If the library is
+ * built with MX25519_FORCE_IMPL_<TYPE>, engines are bound to the only
+ * compiled-in implementation without runtime selection and the kernels are
+ * called directly. An unsupported type throws `std::runtime_error` on first
+ * use, which can be avoided by checking `supported()`. Engines are empty and
+ * can be passed around by value.
+ */
+template<type Type = type::autodetect>
+class engine {
+public:
+    static constexpr type requested_type = Type;
+
+    /*
+     * @return true if the current machine supports the implementation.
+     */
+    static bool supported() noexcept {
+        return select() != nullptr;
+    }
+
+    /*
+     * @return the pointer for use with the C API.
+     */
+    static const mx25519_impl* impl() {
+        const mx25519_impl* impl = select();
+        if (impl == nullptr) {
+            throw std::runtime_error("mx25519: implementation not supported");
+        }
+        return impl;
+    }
+
+    /*
+     * @return the selected type. Differs from `Type` for `type::autodetect`.
+     */
+    static type impl_type() {
+        return static_cast<type>(mx25519_impl_type(impl()));
+    }
+
+    /*
+     * See `mx25519_scmul_base()` and `mx25519_scmul_base_unclamped()`.
+     */
+    static pubkey scmul_base(const privkey& key,
+        unclamp flags = unclamp::none)
+    {
+        pubkey result;
+        mx25519_scmul_base_unclamped(impl(), &result, &key,
+            static_cast<mx25519_unclamp_flags>(flags));
+        return result;
+    }
+
+    /*
+     * See `mx25519_scmul_key()` and `mx25519_scmul_key_unclamped()`.
+     */
+    static pubkey scmul_key(const privkey& key, const pubkey& p,
+        unclamp flags = unclamp::none)
+    {
+        pubkey result;
+        mx25519_scmul_key_unclamped(impl(), &result, &key, &p,
+            static_cast<mx25519_unclamp_flags>(flags));
+        return result;
+    }
+
+    /*
+     * See `mx25519_scmul_base_full()`.
+     */
+    static point scmul_base_full(const privkey& key) {
+        point result;
+        mx25519_scmul_base_full(impl(), &result, &key);
+        return result;
+    }
+
+    /*
+     * See `mx25519_scmul_key_full()`.
+     */
+    static point scmul_key_full(const privkey& key, const point& p) {
+        point result;
+        mx25519_scmul_key_full(impl(), &result, &key, &p);
+        return result;
+    }
+
+    /*
+     * See `mx25519_scmul_base_and_key()`. Returns {x(key*G), x(key*P)}.
+     */
+    static std::pair<pubkey, pubkey> scmul_base_and_key(const privkey& key,
+        const pubkey& p)
+    {
+        std::pair<pubkey, pubkey> result;
+        mx25519_scmul_base_and_key(impl(), &result.first, &result.second,
+            &key, &p);
+        return result;
+    }
+
+    /*
+     * Calculates results[i] = x(keys[i]*G). All spans must have the same
+     * size, otherwise `std::length_error` is thrown.
+     */
+    static void scmul_base(std::span<pubkey> results,
+        std::span<const privkey> keys)
+    {
+        detail::check_batch(results.size(), keys.size());
+        const mx25519_impl* impl = engine::impl();
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            mx25519_scmul_base(impl, &results[i], &keys[i]);
+        }
+    }
+
+    /*
+     * Calculates results[i] = x(keys[i]*points[i]) using
+     * `mx25519_scmul_key_batch()`. All spans must have the same size,
+     * otherwise `std::length_error` is thrown.
+     */
+    static void scmul_key(std::span<pubkey> results,
+        std::span<const privkey> keys, std::span<const pubkey> points)
+    {
+        detail::check_batch(results.size(), keys.size());
+        detail::check_batch(points.size(), keys.size());
+        mx25519_scmul_key_batch(impl(), results.data(), keys.data(),
+            points.data(), keys.size());
+    }
+
+#ifdef MX25519_HAS_EXECUTION
+    /*
+     * Like the batch functions above, but the batch is split into chunks
+     * which are processed according to the execution policy, e.g.
+     * `std::execution::par`. Unsequenced policies are not supported because
+     * the library functions are not vectorization-safe.
+     */
+    template<class ExecutionPolicy>
+        requires detail::supported_policy<ExecutionPolicy>
+    static void scmul_base(ExecutionPolicy&& policy,
+        std::span<pubkey> results, std::span<const privkey> keys)
+    {
+        detail::check_batch(results.size(), keys.size());
+        const mx25519_impl* impl = engine::impl();
+        std::for_each(std::forward<ExecutionPolicy>(policy),
+            detail::index_iterator(0), detail::index_iterator(keys.size()),
+            [=](std::size_t i) {
+                mx25519_scmul_base(impl, &results[i], &keys[i]);
+            });
+    }
+
+    template<class ExecutionPolicy>
+        requires detail::supported_policy<ExecutionPolicy>
+    static void scmul_key(ExecutionPolicy&& policy,
+        std::span<pubkey> results, std::span<const privkey> keys,
+        std::span<const pubkey> points)
+    {
+        detail::check_batch(results.size(), keys.size());
+        detail::check_batch(points.size(), keys.size());
+        const mx25519_impl* impl = engine::impl();
+        const std::size_t chunk = detail::parallel_chunk;
+        const std::size_t chunks = (keys.size() + chunk - 1) / chunk;
+        std::for_each(std::forward<ExecutionPolicy>(policy),
+            detail::index_iterator(0), detail::index_iterator(chunks),
+            [=](std::size_t c) {
+                std::size_t first = c * chunk;
+                std::size_t count = std::min(chunk, keys.size() - first);
+                mx25519_scmul_key_batch(impl, &results[first], &keys[first],
+                    &points[first], count);
+            });
+    }
+#endif
+
+private:
+    static const mx25519_impl* select() noexcept {
+#ifdef MX25519_FORCE_IMPL
+        if constexpr (Type == type::autodetect ||
+            static_cast<mx25519_type>(Type) == MX25519_FORCE_IMPL) {
+            return &mx25519_impl_forced;
+        }
+        else {
+            return nullptr;
+        }
+#else
+        static const mx25519_impl* const impl =
+            mx25519_select_impl(static_cast<mx25519_type>(Type));
+        return impl;
+#endif
+    }
+};
+
+using auto_engine = engine<type::autodetect>;
+using portable_engine = engine<type::portable>;
+using arm64_engine = engine<type::arm64>;
+using amd64_engine = engine<type::amd64>;
+using amd64x_engine = engine<type::amd64x>;
+using arm64_mul64_engine = engine<type::arm64_mul64>;
+using amd64_mulx_engine = engine<type::amd64_mulx>;
+using amd64x_compact_engine = engine<type::amd64x_compact>;
+using arm64_sve2_engine = engine<type::arm64_sve2>;
+
+} // namespace mx25519
+
+#endif
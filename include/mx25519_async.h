@@ -0,0 +1,131 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+#ifndef MX25519_ASYNC_H
+#define MX25519_ASYNC_H
+
+#include "mx25519.h"
+
+/*
+ * Asynchronous front end for `mx25519_scmul_key()`.
+ *
+ * Requests can be submitted one at a time from any number of threads.
+ * Worker threads coalesce pending requests into batches of up to
+ * `max_batch` entries (see `mx25519_scmul_key_batch()`). A batch is started
+ * when it is full or when the oldest request in it has waited for
+ * `deadline_us` microseconds, whichever comes first.
+ *
+ * This API is only available if the library was built with thread support,
+ * in which case MX25519_ASYNC is defined.
+ */
+
+/*
+ * Opaque struct holding the queues and worker threads.
+ */
+typedef struct mx25519_async mx25519_async;
+
+/*
+ * Completion callback. Called from a worker thread with the `user_data`
+ * pointer given to `mx25519_async_submit()`. The result pointer is only
+ * valid for the duration of the call.
+ */
+typedef void mx25519_async_callback(void* user_data,
+    const mx25519_pubkey* result);
+
+/*
+ * Completed request, returned by `mx25519_async_poll()`.
+ */
+typedef struct mx25519_async_completion {
+    mx25519_pubkey result;
+    void* user_data;
+} mx25519_async_completion;
+
+/*
+ * Configuration. Fields set to zero select the default value.
+ */
+typedef struct mx25519_async_config {
+    const mx25519_impl* impl; /* implementation, must not be NULL */
+    size_t queue_size;        /* maximum number of pending requests (1024) */
+    unsigned threads;         /* number of worker threads (1) */
+    unsigned max_batch;       /* maximum batch size (64) */
+    unsigned deadline_us;     /* maximum wait for a batch to fill (0) */
+    int completion_ring;      /* 1 = use mx25519_async_poll, 0 = callbacks */
+} mx25519_async_config;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Starts the worker threads.
+ *
+ * @param config is a pointer to the configuration. Must not be NULL.
+ *
+ * @return pointer to a new instance or NULL if the resources could not be
+ *         allocated.
+ */
+MX25519_API mx25519_async* mx25519_async_create(
+    const mx25519_async_config* config);
+
+/*
+ * Completes all submitted requests and stops the worker threads. Completions
+ * which were not retrieved by `mx25519_async_poll()` are discarded.
+ * No other function may be called concurrently with this one.
+ *
+ * @param ctx is a pointer to the instance to destroy. Can be NULL.
+ */
+MX25519_API void mx25519_async_destroy(mx25519_async* ctx);
+
+/*
+ * Queues the calculation of x(key*P). This function is thread-safe and
+ * lock-free. The private key is copied and wiped from the internal buffers
+ * after use.
+ *
+ * @param ctx is a pointer to the instance. Must not be NULL.
+ * @param key is a pointer to the private key. Must not be NULL.
+ * @param p is a pointer to the base point P. Must not be NULL.
+ * @param callback is the function to call with the result. Must not be NULL
+ *        unless the instance was created with `completion_ring` set, in
+ *        which case it is ignored.
+ * @param user_data is passed to the callback or returned in the
+ *        completion.
+ *
+ * @return 0 on success, -1 if the queue is full.
+ */
+MX25519_API int mx25519_async_submit(mx25519_async* ctx,
+    const mx25519_privkey* key, const mx25519_pubkey* p,
+    mx25519_async_callback* callback, void* user_data);
+
+/*
+ * Returns a file descriptor that becomes readable when completions are
+ * available. It can be used with poll/epoll/select. The descriptor must not
+ * be read or closed by the caller.
+ *
+ * @param ctx is a pointer to the instance. Must not be NULL.
+ *
+ * @return the file descriptor or -1 if the instance uses callbacks.
+ */
+MX25519_API int mx25519_async_fd(const mx25519_async* ctx);
+
+/*
+ * Retrieves completed requests. Must not be called by more than one thread
+ * at a time. After the descriptor returned by `mx25519_async_fd()` becomes
+ * readable, this function should be called until it returns 0.
+ *
+ * @param ctx is a pointer to the instance. Must not be NULL.
+ * @param out is the array where the completions will be stored.
+ * @param max is the capacity of the `out` array.
+ *
+ * @return the number of completions stored in `out`.
+ */
+MX25519_API size_t mx25519_async_poll(mx25519_async* ctx,
+    mx25519_async_completion* out, size_t max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
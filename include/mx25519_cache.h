@@ -0,0 +1,142 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+#ifndef MX25519_CACHE_H
+#define MX25519_CACHE_H
+
+#include "mx25519.h"
+
+/*
+ * Cache of static-static shared secrets x(k*P).
+ *
+ * Handshakes such as Noise IK/XX or X3DH compute the same DH(s, rs) every
+ * time a peer reconnects. The cache remembers the results for the most
+ * recently used (local key, peer public key) pairs, so repeated handshakes
+ * skip the scalar multiplication.
+ *
+ * Local private keys are registered once and referred to by a handle.
+ * Entries are split into shards with independent locks and the least
+ * recently used entry of a shard is evicted when it is full. The keys and
+ * the secrets are stored in memory which is locked (`mlock`), excluded from
+ * core dumps where supported and wiped when an entry is evicted or
+ * invalidated. Peer keys are compared in constant time.
+ *
+ * A cache hit is much faster than a miss, so the timing of a handshake
+ * tells an observer whether the peer connected recently. Entries are not
+ * validated: a low-order peer key is cached like any other.
+ *
+ * This API is only available if the library was built with thread support,
+ * in which case MX25519_CACHE is defined.
+ */
+
+/*
+ * Opaque struct holding the cache.
+ */
+typedef struct mx25519_cache mx25519_cache;
+
+/*
+ * Configuration. Fields set to zero select the default value.
+ */
+typedef struct mx25519_cache_config {
+    const mx25519_impl* impl; /* implementation, must not be NULL */
+    size_t capacity;          /* maximum number of cached secrets (4096) */
+    unsigned shards;          /* number of shards, rounded up to a power
+                                 of 2 (16) */
+    unsigned max_keys;        /* maximum number of local keys (4) */
+    int allow_unlocked;       /* 1 = continue if the memory cannot be
+                                 locked, 0 = fail */
+} mx25519_cache_config;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Allocates a cache.
+ *
+ * @param config is a pointer to the configuration. Must not be NULL.
+ *
+ * @return pointer to a new cache or NULL if the memory could not be
+ *         allocated or locked, if /dev/urandom could not be read, or if
+ *         the capacity exceeds UINT32_MAX or the number of shards exceeds
+ *         2^31.
+ */
+MX25519_API mx25519_cache* mx25519_cache_create(
+    const mx25519_cache_config* config);
+
+/*
+ * Wipes and frees the cache, including the local keys. No other function
+ * may be called concurrently with this one.
+ *
+ * @param cache is a pointer to the cache to destroy. Can be NULL.
+ */
+MX25519_API void mx25519_cache_destroy(mx25519_cache* cache);
+
+/*
+ * Registers a local private key. The key is copied into locked memory.
+ * This function is thread-safe.
+ *
+ * @param cache is a pointer to the cache. Must not be NULL.
+ * @param key is a pointer to the private key. Must not be NULL.
+ *
+ * @return a non-negative handle or -1 if `max_keys` keys are registered.
+ */
+MX25519_API int mx25519_cache_add_key(mx25519_cache* cache,
+    const mx25519_privkey* key);
+
+/*
+ * Wipes a local key and all secrets calculated with it. The handle may be
+ * returned again by a later `mx25519_cache_add_key()` call. This function
+ * is thread-safe.
+ *
+ * @param cache is a pointer to the cache. Must not be NULL.
+ * @param handle is a handle returned by `mx25519_cache_add_key()`.
+ */
+MX25519_API void mx25519_cache_remove_key(mx25519_cache* cache, int handle);
+
+/*
+ * Calculates x(key*P) like `mx25519_scmul_key()`, where key is the local
+ * key with the given handle. The result is taken from the cache if
+ * possible, otherwise it is calculated and cached. This function is
+ * thread-safe. The scalar multiplication runs without holding any lock.
+ *
+ * @param cache is a pointer to the cache. Must not be NULL.
+ * @param result is a pointer where the result will be stored.
+ *        Must not be NULL.
+ * @param handle is a handle returned by `mx25519_cache_add_key()`.
+ * @param p is a pointer to the peer public key P. Must not be NULL.
+ *
+ * @return 1 if the result was cached, 0 if it was calculated, -1 if the
+ *         handle is not valid.
+ */
+MX25519_API int mx25519_cache_scmul_key(mx25519_cache* cache,
+    mx25519_pubkey* result, int handle, const mx25519_pubkey* p);
+
+/*
+ * Wipes the secrets of a peer for all local keys, e.g. when the peer key
+ * is revoked. This function is thread-safe.
+ *
+ * @param cache is a pointer to the cache. Must not be NULL.
+ * @param p is a pointer to the peer public key. Must not be NULL.
+ *
+ * @return the number of removed entries.
+ */
+MX25519_API size_t mx25519_cache_invalidate(mx25519_cache* cache,
+    const mx25519_pubkey* p);
+
+/*
+ * Wipes all cached secrets. The local keys stay registered. This function
+ * is thread-safe.
+ *
+ * @param cache is a pointer to the cache. Must not be NULL.
+ */
+MX25519_API void mx25519_cache_clear(mx25519_cache* cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,49 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+/*
+ * Compiles the C part of the library as a single translation unit, so that
+ * the compiler can inline the selected kernel into the API functions. It can
+ * also be included directly into an application source file, e.g.:
+ *
+ *     #define MX25519_STATIC
+ *     #define MX25519_FORCE_IMPL_PORTABLE
+ *     #include "mx25519/src/amalgamation.c"
+ *
+ * The assembly files of the ARM64 and AMD64 implementations, src/async.c,
+ * src/cache.c and src/arm64/scalarmult_sve2.c (which needs
+ * -march=armv8-a+sve2) must still be compiled separately.
+ */
+
+#include "platform.h"
+#include "impl.h"
+
+#if !defined(MX25519_FORCE_IMPL) || defined(MX25519_FORCE_IMPL_PORTABLE)
+#include "portable/scalarmult.c"
+#endif
+#if defined(PLATFORM_ARM64) \
+    && (!defined(MX25519_FORCE_IMPL) || defined(MX25519_FORCE_IMPL_ARM64))
+#include "arm64/scalarmult.c"
+#endif
+#if defined(PLATFORM_ARM64) && (!defined(MX25519_FORCE_IMPL) \
+    || defined(MX25519_FORCE_IMPL_ARM64_MUL64))
+#include "arm64/scalarmult_mul64.c"
+#endif
+#if defined(PLATFORM_AMD64) && (!defined(MX25519_FORCE_IMPL) \
+    || defined(MX25519_FORCE_IMPL_AMD64) || defined(MX25519_FORCE_IMPL_AMD64X) \
+    || defined(MX25519_FORCE_IMPL_AMD64_MULX) \
+    || defined(MX25519_FORCE_IMPL_AMD64X_COMPACT))
+#include "amd64/scalarmult_gpr.c"
+#endif
+#include "portable/point.c"
+#ifndef MX25519_FORCE_IMPL
+#include "cpu.c"
+#endif
+#include "impl.c"
+#include "resumable.c"
+#include "scalar.c"
+#include "stats.c"
+#include "mx25519.c"
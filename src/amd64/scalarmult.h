@@ -21,4 +21,119 @@ void mx25519_scalarmult_amd64x(uint8_t* q,
     uint8_t clamp_lo,
     uint8_t clamp_hi);
 
+/*
+ * Like the functions above, but specialized for the base point u = 9.
+ * The ladder multiplies by 9 instead of X1. p must point to the
+ * encoding of 9.
+ */
+void mx25519_scalarmult_amd64_base(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi);
+
+void mx25519_scalarmult_amd64x_base(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi);
+
+/*
+ * Like the scalarmult functions, but output the projective ladder result
+ * X2, Z2, X3, Z3 as 4 little-endian 256-bit integers.
+ */
+void mx25519_ladder_amd64(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi);
+
+void mx25519_ladder_amd64_base(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi);
+
+void mx25519_ladder_amd64x(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi);
+
+void mx25519_ladder_amd64x_base(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi);
+
+/*
+ * MULX kernel for CPUs without ADX, see scalarmult_mulx.inc.
+ */
+void mx25519_scalarmult_amd64_mulx(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi);
+
+void mx25519_scalarmult_amd64_mulx_base(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi);
+
+void mx25519_ladder_amd64_mulx(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi);
+
+void mx25519_ladder_amd64_mulx_base(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi);
+
+/*
+ * Size-optimized MULX/ADX kernel, see scalarmult_compact.inc.
+ */
+void mx25519_scalarmult_amd64x_compact(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi);
+
+void mx25519_scalarmult_amd64x_compact_base(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi);
+
+void mx25519_ladder_amd64x_compact(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi);
+
+void mx25519_ladder_amd64x_compact_base(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi);
+
+/*
+ * AMD64X without AVX2, see scalarmult_gpr.c. All state is kept in
+ * general-purpose registers and memory.
+ */
+void mx25519_scalarmult_amd64x_gpr(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi);
+
+void mx25519_scalarmult_amd64x_gpr_base(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi);
+
 #endif
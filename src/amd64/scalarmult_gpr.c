@@ -0,0 +1,71 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+/*
+ * AMD64X without AVX2. The assembly kernel only uses ymm registers for the
+ * final inversion, so these functions run its projective ladder, which is
+ * MULX/ADX code on general-purpose registers, and invert in C.
+ */
+
+#include "scalarmult.h"
+#include "../platform.h"
+#ifdef PLATFORM_UINT128
+#include "../portable/fe64.h"
+#else
+#include "../portable/fe.h"
+#endif
+
+/* q <- X2/Z2, xz is the projective ladder result */
+static void gpr_finish(uint8_t* q, const uint8_t xz[128]) {
+#ifdef PLATFORM_UINT128
+    fe64 x2, z2;
+    int i;
+
+    /* the ladder outputs are not reduced, bit 255 may be set */
+    for (i = 0; i < 4; ++i) {
+        x2[i] = platform_load64(xz + 8 * i);
+        z2[i] = platform_load64(xz + 32 + 8 * i);
+    }
+    fe64_invert(z2, z2);
+    fe64_mul(x2, x2, z2);
+    fe64_tobytes(q, x2);
+#else
+    fe x2, z2;
+
+    /* the ladder outputs are not reduced, bit 255 may be set */
+    fe_frombytes(x2, xz);
+    x2[0] += 19 * (xz[31] >> 7);
+    fe_frombytes(z2, xz + 32);
+    z2[0] += 19 * (xz[63] >> 7);
+    fe_invert(z2, z2);
+    fe_mul(x2, x2, z2);
+    fe_tobytes(q, x2);
+#endif
+}
+
+void mx25519_scalarmult_amd64x_gpr(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi)
+{
+    uint8_t xz[128];
+
+    mx25519_ladder_amd64x(xz, n, p, clamp_lo, clamp_hi);
+    gpr_finish(q, xz);
+}
+
+void mx25519_scalarmult_amd64x_gpr_base(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi)
+{
+    uint8_t xz[128];
+
+    mx25519_ladder_amd64x_base(xz, n, p, clamp_lo, clamp_hi);
+    gpr_finish(q, xz);
+}
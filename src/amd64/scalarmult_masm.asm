@@ -11,13 +11,29 @@ MX25519_SCALARMULT SEGMENT PAGE READ EXECUTE
 
 PUBLIC mx25519_scalarmult_amd64x
 PUBLIC mx25519_scalarmult_amd64
+PUBLIC mx25519_ladder_amd64x
+PUBLIC mx25519_ladder_amd64
+PUBLIC mx25519_scalarmult_amd64x_base
+PUBLIC mx25519_scalarmult_amd64_base
+PUBLIC mx25519_ladder_amd64x_base
+PUBLIC mx25519_scalarmult_amd64_mulx
+PUBLIC mx25519_scalarmult_amd64_mulx_base
+PUBLIC mx25519_ladder_amd64_mulx
+PUBLIC mx25519_ladder_amd64_mulx_base
+PUBLIC mx25519_scalarmult_amd64x_compact
+PUBLIC mx25519_scalarmult_amd64x_compact_base
+PUBLIC mx25519_ladder_amd64x_compact
+PUBLIC mx25519_ladder_amd64x_compact_base
+PUBLIC mx25519_ladder_amd64_base
 
 include constants.inc
 
 ALIGN 32
 include gcd_table.inc
 
-mx25519_scalarmult_amd64x PROC
+; the xmm registers are saved with SSE moves, so that the projective
+; ladder entries don't execute any AVX instructions
+amd64x_prologue MACRO
   mov   qword ptr [rsp+8], rdi
   mov   qword ptr [rsp+16], rsi
   mov   rdi, rcx
@@ -26,36 +42,139 @@ mx25519_scalarmult_amd64x PROC
   mov   rcx, r9
   movzx r8, byte ptr [rsp+40]
   sub   rsp, 160
-  vmovdqu xmmword ptr [rsp+144], xmm6
-  vmovdqu xmmword ptr [rsp+128], xmm7
-  vmovdqu xmmword ptr [rsp+112], xmm8
-  vmovdqu xmmword ptr [rsp+96], xmm9
-  vmovdqu xmmword ptr [rsp+80], xmm10
-  vmovdqu xmmword ptr [rsp+64], xmm11
-  vmovdqu xmmword ptr [rsp+48], xmm12
-  vmovdqu xmmword ptr [rsp+32], xmm13
-  vmovdqu xmmword ptr [rsp+16], xmm14
-  vmovdqu xmmword ptr [rsp], xmm15
-
-include scalarmult_mulx_adx.inc
+  movdqu xmmword ptr [rsp+144], xmm6
+  movdqu xmmword ptr [rsp+128], xmm7
+  movdqu xmmword ptr [rsp+112], xmm8
+  movdqu xmmword ptr [rsp+96], xmm9
+  movdqu xmmword ptr [rsp+80], xmm10
+  movdqu xmmword ptr [rsp+64], xmm11
+  movdqu xmmword ptr [rsp+48], xmm12
+  movdqu xmmword ptr [rsp+32], xmm13
+  movdqu xmmword ptr [rsp+16], xmm14
+  movdqu xmmword ptr [rsp], xmm15
+ENDM
 
-  vmovdqu xmm15, xmmword ptr [rsp]
-  vmovdqu xmm14, xmmword ptr [rsp+16]
-  vmovdqu xmm13, xmmword ptr [rsp+32]
-  vmovdqu xmm12, xmmword ptr [rsp+48]
-  vmovdqu xmm11, xmmword ptr [rsp+64]
-  vmovdqu xmm10, xmmword ptr [rsp+80]
-  vmovdqu xmm9, xmmword ptr [rsp+96]
-  vmovdqu xmm8, xmmword ptr [rsp+112]
-  vmovdqu xmm7, xmmword ptr [rsp+128]
-  vmovdqu xmm6, xmmword ptr [rsp+144]
+amd64x_epilogue MACRO
+  movdqu xmm15, xmmword ptr [rsp]
+  movdqu xmm14, xmmword ptr [rsp+16]
+  movdqu xmm13, xmmword ptr [rsp+32]
+  movdqu xmm12, xmmword ptr [rsp+48]
+  movdqu xmm11, xmmword ptr [rsp+64]
+  movdqu xmm10, xmmword ptr [rsp+80]
+  movdqu xmm9, xmmword ptr [rsp+96]
+  movdqu xmm8, xmmword ptr [rsp+112]
+  movdqu xmm7, xmmword ptr [rsp+128]
+  movdqu xmm6, xmmword ptr [rsp+144]
   add   rsp, 160
   mov   rdi, qword ptr [rsp+8]
   mov   rsi, qword ptr [rsp+16]
+ENDM
+
+mx25519_ladder_amd64x PROC
+  mov   eax, 1
+  jmp   amd64x_entry
+mx25519_ladder_amd64x ENDP
+
+mx25519_scalarmult_amd64x_base PROC
+  mov   eax, 2
+  jmp   amd64x_entry
+mx25519_scalarmult_amd64x_base ENDP
+
+mx25519_ladder_amd64x_base PROC
+  mov   eax, 3
+  jmp   amd64x_entry
+mx25519_ladder_amd64x_base ENDP
+
+mx25519_scalarmult_amd64x PROC
+  xor   eax, eax
+amd64x_entry::
+  amd64x_prologue
+
+include scalarmult_mulx_adx.inc
+
+  amd64x_epilogue
   ret
 mx25519_scalarmult_amd64x ENDP
 
+; MULX without ADX, only used by Intel Haswell and AMD Excavator
+mx25519_ladder_amd64_mulx PROC
+  mov   eax, 1
+  jmp   amd64_mulx_entry
+mx25519_ladder_amd64_mulx ENDP
+
+mx25519_scalarmult_amd64_mulx_base PROC
+  mov   eax, 2
+  jmp   amd64_mulx_entry
+mx25519_scalarmult_amd64_mulx_base ENDP
+
+mx25519_ladder_amd64_mulx_base PROC
+  mov   eax, 3
+  jmp   amd64_mulx_entry
+mx25519_ladder_amd64_mulx_base ENDP
+
+mx25519_scalarmult_amd64_mulx PROC
+  xor   eax, eax
+amd64_mulx_entry::
+  amd64x_prologue
+
+include scalarmult_mulx.inc
+
+  amd64x_epilogue
+  ret
+mx25519_scalarmult_amd64_mulx ENDP
+
+; MULX/ADX with the field operations called as subroutines, no xmm registers
+mx25519_ladder_amd64x_compact PROC
+  mov   eax, 1
+  jmp   amd64x_compact_entry
+mx25519_ladder_amd64x_compact ENDP
+
+mx25519_scalarmult_amd64x_compact_base PROC
+  mov   eax, 2
+  jmp   amd64x_compact_entry
+mx25519_scalarmult_amd64x_compact_base ENDP
+
+mx25519_ladder_amd64x_compact_base PROC
+  mov   eax, 3
+  jmp   amd64x_compact_entry
+mx25519_ladder_amd64x_compact_base ENDP
+
+mx25519_scalarmult_amd64x_compact PROC
+  xor   eax, eax
+amd64x_compact_entry::
+  mov   qword ptr [rsp+8], rdi
+  mov   qword ptr [rsp+16], rsi
+  mov   rdi, rcx
+  mov   rsi, rdx
+  mov   rdx, r8
+  mov   rcx, r9
+  movzx r8, byte ptr [rsp+40]
+
+include scalarmult_compact.inc
+
+  mov   rdi, qword ptr [rsp+8]
+  mov   rsi, qword ptr [rsp+16]
+  ret
+mx25519_scalarmult_amd64x_compact ENDP
+
+mx25519_ladder_amd64 PROC
+  mov   eax, 1
+  jmp   amd64_entry
+mx25519_ladder_amd64 ENDP
+
+mx25519_scalarmult_amd64_base PROC
+  mov   eax, 2
+  jmp   amd64_entry
+mx25519_scalarmult_amd64_base ENDP
+
+mx25519_ladder_amd64_base PROC
+  mov   eax, 3
+  jmp   amd64_entry
+mx25519_ladder_amd64_base ENDP
+
 mx25519_scalarmult_amd64 PROC
+  xor   eax, eax
+amd64_entry::
   mov   qword ptr [rsp+8], rdi
   mov   qword ptr [rsp+16], rsi
   mov   rdi, rcx
@@ -0,0 +1,69 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+#include "scalarmult.h"
+#include "../portable/fe64.h"
+
+/* bit offsets of the radix 2^25.5 limbs */
+static const int limb_shift[10] = {
+    0, 26, 51, 77, 102, 128, 153, 179, 204, 230
+};
+
+/* Converts 10 limbs in radix 2^25.5 to 4 64-bit limbs. */
+static void fe64_fromlimbs(fe64 h, const uint32_t limbs[10]) {
+    uint64_t t[8] = { 0 };
+    int i, j;
+
+    for (i = 0; i < 10; ++i) {
+        int w = limb_shift[i] / 64;
+        uint128_t v = (uint128_t)limbs[i] << (limb_shift[i] % 64);
+        uint128_t c = (uint128_t)t[w] + (uint64_t)v;
+        t[w] = (uint64_t)c;
+        c = (uint128_t)t[w + 1] + (uint64_t)(v >> 64) + (uint64_t)(c >> 64);
+        t[w + 1] = (uint64_t)c;
+        for (j = w + 2; j < 5; ++j) {
+            c = (uint128_t)t[j] + (uint64_t)(c >> 64);
+            t[j] = (uint64_t)c;
+        }
+    }
+    fe64_reduce512(h, t);
+}
+
+void mx25519_scalarmult_arm64(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi)
+{
+    uint32_t xz[40];
+    fe64 x2, z2;
+
+    mx25519_ladder_arm64_neon(xz, n, p, clamp_lo, clamp_hi);
+
+    fe64_fromlimbs(x2, &xz[0]);
+    fe64_fromlimbs(z2, &xz[10]);
+    fe64_invert(z2, z2);
+    fe64_mul(x2, x2, z2);
+    fe64_tobytes(q, x2);
+}
+
+void mx25519_ladder_arm64(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi)
+{
+    uint32_t limbs[40];
+    fe64 t;
+    int i;
+
+    mx25519_ladder_arm64_neon(limbs, n, p, clamp_lo, clamp_hi);
+
+    for (i = 0; i < 4; ++i) {
+        fe64_fromlimbs(t, &limbs[10 * i]);
+        fe64_tobytes(&xz[32 * i], t);
+    }
+}
@@ -7,12 +7,94 @@
 #ifndef ARM64_SCALARMULT_H
 #define ARM64_SCALARMULT_H
 
+#include <stddef.h>
 #include <stdint.h>
 
+/*
+ * Runs the Montgomery ladder and outputs the projective results (X2:Z2)
+ * and (X3:Z3) as 4 x 10 limbs in radix 2^25.5.
+ */
+void mx25519_ladder_arm64_neon(uint32_t xz[40],
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi);
+
 void mx25519_scalarmult_arm64(uint8_t* q,
     const uint8_t* n,
     const uint8_t* p,
     const uint8_t clamp_lo,
     const uint8_t clamp_hi);
 
+void mx25519_ladder_arm64(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi);
+
+/* 64-bit limb ladder using scalar mul/umulh, see scalarmult_mul64.c */
+void mx25519_scalarmult_arm64_mul64(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi);
+
+/* p is ignored, the base point u = 9 is used */
+void mx25519_scalarmult_arm64_mul64_base(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi);
+
+void mx25519_ladder_arm64_mul64(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi);
+
+/* p is ignored, the base point u = 9 is used */
+void mx25519_ladder_arm64_mul64_base(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi);
+
+/*
+ * SVE2 ladder with one key per 64-bit vector lane, see scalarmult_sve2.c.
+ * Only available if the library was built with MX25519_SVE2.
+ */
+void mx25519_scalarmult_arm64_sve2(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi);
+
+/* p is ignored, the base point u = 9 is used */
+void mx25519_scalarmult_arm64_sve2_base(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi);
+
+void mx25519_ladder_arm64_sve2(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi);
+
+/* p is ignored, the base point u = 9 is used */
+void mx25519_ladder_arm64_sve2_base(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi);
+
+/* groups of up to 32 keys, svcntd() lanes per instruction */
+void mx25519_ladder_batch_arm64_sve2(uint8_t* xz,
+    const uint8_t* keys,
+    const uint8_t* points,
+    size_t count,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi);
+
 #endif
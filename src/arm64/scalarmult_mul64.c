@@ -0,0 +1,137 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+/*
+ * Montgomery ladder with 4 64-bit limbs. The field multiplications compile
+ * to mul/umulh pairs with adds/adcs carry chains, which is faster than the
+ * NEON ladder on wide out-of-order cores with several scalar multipliers.
+ */
+
+#include "scalarmult.h"
+#include "../portable/fe64.h"
+#include "../portable/ladder64.h"
+
+#include <stddef.h>
+
+/* (x2:z2) <- n*P, (x3:z3) <- (n+1)*P, P is the base point if p is NULL */
+static void ladder64(fe64 x2, fe64 z2, fe64 x3, fe64 z3,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi)
+{
+    uint8_t e[32];
+    unsigned int i;
+    fe64 x1;
+    int pos;
+    unsigned int swap;
+    unsigned int b;
+
+    for (i = 0; i < 32; ++i) e[i] = n[i];
+    e[0] &= clamp_lo;
+    e[31] |= clamp_hi;
+    // bit 255 is cleared implicitly by virtue of ignoring it
+    if (p != NULL) {
+        fe64_frombytes(x1, p);
+    }
+    else {
+        x1[0] = 9;
+        x1[1] = x1[2] = x1[3] = 0;
+    }
+    for (i = 0; i < 4; ++i) {
+        x2[i] = 0;
+        z2[i] = 0;
+        x3[i] = x1[i];
+        z3[i] = 0;
+    }
+    x2[0] = 1;
+    z3[0] = 1;
+
+    swap = 0;
+    for (pos = 254; pos >= 0; --pos) {
+        b = e[pos / 8] >> (pos & 7);
+        b &= 1;
+        ladder64_step(p != NULL ? x1 : NULL, x2, z2, x3, z3, &swap, b);
+    }
+    fe64_cswap(x2, x3, swap);
+    fe64_cswap(z2, z3, swap);
+}
+
+void mx25519_scalarmult_arm64_mul64(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi)
+{
+    fe64 x2;
+    fe64 z2;
+    fe64 x3;
+    fe64 z3;
+
+    ladder64(x2, z2, x3, z3, n, p, clamp_lo, clamp_hi);
+
+    fe64_invert(z2, z2);
+    fe64_mul(x2, x2, z2);
+    fe64_tobytes(q, x2);
+}
+
+void mx25519_scalarmult_arm64_mul64_base(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi)
+{
+    fe64 x2;
+    fe64 z2;
+    fe64 x3;
+    fe64 z3;
+
+    (void)p;
+    ladder64(x2, z2, x3, z3, n, NULL, clamp_lo, clamp_hi);
+
+    fe64_invert(z2, z2);
+    fe64_mul(x2, x2, z2);
+    fe64_tobytes(q, x2);
+}
+
+void mx25519_ladder_arm64_mul64(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi)
+{
+    fe64 x2;
+    fe64 z2;
+    fe64 x3;
+    fe64 z3;
+
+    ladder64(x2, z2, x3, z3, n, p, clamp_lo, clamp_hi);
+
+    fe64_tobytes(xz, x2);
+    fe64_tobytes(xz + 32, z2);
+    fe64_tobytes(xz + 64, x3);
+    fe64_tobytes(xz + 96, z3);
+}
+
+void mx25519_ladder_arm64_mul64_base(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi)
+{
+    fe64 x2;
+    fe64 z2;
+    fe64 x3;
+    fe64 z3;
+
+    (void)p;
+    ladder64(x2, z2, x3, z3, n, NULL, clamp_lo, clamp_hi);
+
+    fe64_tobytes(xz, x2);
+    fe64_tobytes(xz + 32, z2);
+    fe64_tobytes(xz + 64, x3);
+    fe64_tobytes(xz + 96, z3);
+}
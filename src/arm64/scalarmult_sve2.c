@@ -0,0 +1,546 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+/*
+ * Multi-lane Montgomery ladder for SVE2. Each 64-bit vector lane runs an
+ * independent ladder with the ref10 field arithmetic (10 limbs in radix
+ * 2^25.5), so a call computes up to SVE2_LANES scalar multiplications.
+ * The field operations are strip-mined over the lanes with svwhilelt, so
+ * the same code runs with any vector length from 128 to 2048 bits.
+ *
+ * The limbs are stored transposed: row j of a vfe holds limb j of every
+ * lane. All lanes execute the same instructions, the key bits only select
+ * the conditional swap masks.
+ *
+ * This file is compiled with -march=armv8-a+sve2. The functions must only
+ * be called if the CPU supports SVE2.
+ */
+
+#include "scalarmult.h"
+#include "../portable/fe.h"
+
+#include <arm_sve.h>
+#include <string.h>
+
+#define SVE2_LANES 32
+
+typedef int64_t vfe[10][SVE2_LANES];
+
+/* rounding carry from limb a (s bits) to limb b, uses the SVE2 SRSHR */
+#define CARRY(a, b, s)                                  \
+    c = svrshr_n_s64_x(pg, a, s);                       \
+    b = svadd_s64_x(pg, b, c);                          \
+    a = svsub_s64_x(pg, a, svlsl_n_s64_x(pg, c, s))
+
+#define CARRY19(a, b, s)                                \
+    c = svrshr_n_s64_x(pg, a, s);                       \
+    b = svmla_n_s64_x(pg, b, c, 19);                    \
+    a = svsub_s64_x(pg, a, svlsl_n_s64_x(pg, c, s))
+
+#define LOAD(x, v, j) svint64_t x##j = svld1_s64(pg, &v[j][i])
+
+#define LOAD10(x, v)                                    \
+    LOAD(x, v, 0); LOAD(x, v, 1); LOAD(x, v, 2);        \
+    LOAD(x, v, 3); LOAD(x, v, 4); LOAD(x, v, 5);        \
+    LOAD(x, v, 6); LOAD(x, v, 7); LOAD(x, v, 8);        \
+    LOAD(x, v, 9)
+
+/*
+ * Carries the products of vfe_mul and vfe_sq like fe_mul and stores them
+ * to h[.][i].
+ */
+static inline void vfe_carry_store(svbool_t pg, vfe h, size_t i,
+    svint64_t h0, svint64_t h1, svint64_t h2, svint64_t h3, svint64_t h4,
+    svint64_t h5, svint64_t h6, svint64_t h7, svint64_t h8, svint64_t h9)
+{
+    svint64_t c;
+
+    CARRY(h0, h1, 26);
+    CARRY(h4, h5, 26);
+    CARRY(h1, h2, 25);
+    CARRY(h5, h6, 25);
+    CARRY(h2, h3, 26);
+    CARRY(h6, h7, 26);
+    CARRY(h3, h4, 25);
+    CARRY(h7, h8, 25);
+    CARRY(h4, h5, 26);
+    CARRY(h8, h9, 26);
+    CARRY19(h9, h0, 25);
+    CARRY(h0, h1, 26);
+
+    svst1_s64(pg, &h[0][i], h0);
+    svst1_s64(pg, &h[1][i], h1);
+    svst1_s64(pg, &h[2][i], h2);
+    svst1_s64(pg, &h[3][i], h3);
+    svst1_s64(pg, &h[4][i], h4);
+    svst1_s64(pg, &h[5][i], h5);
+    svst1_s64(pg, &h[6][i], h6);
+    svst1_s64(pg, &h[7][i], h7);
+    svst1_s64(pg, &h[8][i], h8);
+    svst1_s64(pg, &h[9][i], h9);
+}
+
+/* h = f + g for lanes 0..n-1, see fe_add */
+static void vfe_add(vfe h, vfe f, vfe g, size_t n) {
+    size_t i;
+    int j;
+
+    for (i = 0; i < n; i += svcntd()) {
+        svbool_t pg = svwhilelt_b64_u64(i, n);
+        for (j = 0; j < 10; ++j) {
+            svst1_s64(pg, &h[j][i], svadd_s64_x(pg,
+                svld1_s64(pg, &f[j][i]), svld1_s64(pg, &g[j][i])));
+        }
+    }
+}
+
+/* h = f - g for lanes 0..n-1, see fe_sub */
+static void vfe_sub(vfe h, vfe f, vfe g, size_t n) {
+    size_t i;
+    int j;
+
+    for (i = 0; i < n; i += svcntd()) {
+        svbool_t pg = svwhilelt_b64_u64(i, n);
+        for (j = 0; j < 10; ++j) {
+            svst1_s64(pg, &h[j][i], svsub_s64_x(pg,
+                svld1_s64(pg, &f[j][i]), svld1_s64(pg, &g[j][i])));
+        }
+    }
+}
+
+/* h = f * g for lanes 0..n-1, see fe_mul for the bounds */
+static void vfe_mul(vfe h, vfe f, vfe g, size_t n) {
+    size_t i;
+
+    for (i = 0; i < n; i += svcntd()) {
+        svbool_t pg = svwhilelt_b64_u64(i, n);
+        LOAD10(f, f);
+        LOAD10(g, g);
+        svint64_t g1_19 = svmul_n_s64_x(pg, g1, 19);
+        svint64_t g2_19 = svmul_n_s64_x(pg, g2, 19);
+        svint64_t g3_19 = svmul_n_s64_x(pg, g3, 19);
+        svint64_t g4_19 = svmul_n_s64_x(pg, g4, 19);
+        svint64_t g5_19 = svmul_n_s64_x(pg, g5, 19);
+        svint64_t g6_19 = svmul_n_s64_x(pg, g6, 19);
+        svint64_t g7_19 = svmul_n_s64_x(pg, g7, 19);
+        svint64_t g8_19 = svmul_n_s64_x(pg, g8, 19);
+        svint64_t g9_19 = svmul_n_s64_x(pg, g9, 19);
+        svint64_t f1_2 = svadd_s64_x(pg, f1, f1);
+        svint64_t f3_2 = svadd_s64_x(pg, f3, f3);
+        svint64_t f5_2 = svadd_s64_x(pg, f5, f5);
+        svint64_t f7_2 = svadd_s64_x(pg, f7, f7);
+        svint64_t f9_2 = svadd_s64_x(pg, f9, f9);
+        svint64_t h0 = svmul_s64_x(pg, f0, g0);
+        h0 = svmla_s64_x(pg, h0, f1_2, g9_19);
+        h0 = svmla_s64_x(pg, h0, f2, g8_19);
+        h0 = svmla_s64_x(pg, h0, f3_2, g7_19);
+        h0 = svmla_s64_x(pg, h0, f4, g6_19);
+        h0 = svmla_s64_x(pg, h0, f5_2, g5_19);
+        h0 = svmla_s64_x(pg, h0, f6, g4_19);
+        h0 = svmla_s64_x(pg, h0, f7_2, g3_19);
+        h0 = svmla_s64_x(pg, h0, f8, g2_19);
+        h0 = svmla_s64_x(pg, h0, f9_2, g1_19);
+        svint64_t h1 = svmul_s64_x(pg, f0, g1);
+        h1 = svmla_s64_x(pg, h1, f1, g0);
+        h1 = svmla_s64_x(pg, h1, f2, g9_19);
+        h1 = svmla_s64_x(pg, h1, f3, g8_19);
+        h1 = svmla_s64_x(pg, h1, f4, g7_19);
+        h1 = svmla_s64_x(pg, h1, f5, g6_19);
+        h1 = svmla_s64_x(pg, h1, f6, g5_19);
+        h1 = svmla_s64_x(pg, h1, f7, g4_19);
+        h1 = svmla_s64_x(pg, h1, f8, g3_19);
+        h1 = svmla_s64_x(pg, h1, f9, g2_19);
+        svint64_t h2 = svmul_s64_x(pg, f0, g2);
+        h2 = svmla_s64_x(pg, h2, f1_2, g1);
+        h2 = svmla_s64_x(pg, h2, f2, g0);
+        h2 = svmla_s64_x(pg, h2, f3_2, g9_19);
+        h2 = svmla_s64_x(pg, h2, f4, g8_19);
+        h2 = svmla_s64_x(pg, h2, f5_2, g7_19);
+        h2 = svmla_s64_x(pg, h2, f6, g6_19);
+        h2 = svmla_s64_x(pg, h2, f7_2, g5_19);
+        h2 = svmla_s64_x(pg, h2, f8, g4_19);
+        h2 = svmla_s64_x(pg, h2, f9_2, g3_19);
+        svint64_t h3 = svmul_s64_x(pg, f0, g3);
+        h3 = svmla_s64_x(pg, h3, f1, g2);
+        h3 = svmla_s64_x(pg, h3, f2, g1);
+        h3 = svmla_s64_x(pg, h3, f3, g0);
+        h3 = svmla_s64_x(pg, h3, f4, g9_19);
+        h3 = svmla_s64_x(pg, h3, f5, g8_19);
+        h3 = svmla_s64_x(pg, h3, f6, g7_19);
+        h3 = svmla_s64_x(pg, h3, f7, g6_19);
+        h3 = svmla_s64_x(pg, h3, f8, g5_19);
+        h3 = svmla_s64_x(pg, h3, f9, g4_19);
+        svint64_t h4 = svmul_s64_x(pg, f0, g4);
+        h4 = svmla_s64_x(pg, h4, f1_2, g3);
+        h4 = svmla_s64_x(pg, h4, f2, g2);
+        h4 = svmla_s64_x(pg, h4, f3_2, g1);
+        h4 = svmla_s64_x(pg, h4, f4, g0);
+        h4 = svmla_s64_x(pg, h4, f5_2, g9_19);
+        h4 = svmla_s64_x(pg, h4, f6, g8_19);
+        h4 = svmla_s64_x(pg, h4, f7_2, g7_19);
+        h4 = svmla_s64_x(pg, h4, f8, g6_19);
+        h4 = svmla_s64_x(pg, h4, f9_2, g5_19);
+        svint64_t h5 = svmul_s64_x(pg, f0, g5);
+        h5 = svmla_s64_x(pg, h5, f1, g4);
+        h5 = svmla_s64_x(pg, h5, f2, g3);
+        h5 = svmla_s64_x(pg, h5, f3, g2);
+        h5 = svmla_s64_x(pg, h5, f4, g1);
+        h5 = svmla_s64_x(pg, h5, f5, g0);
+        h5 = svmla_s64_x(pg, h5, f6, g9_19);
+        h5 = svmla_s64_x(pg, h5, f7, g8_19);
+        h5 = svmla_s64_x(pg, h5, f8, g7_19);
+        h5 = svmla_s64_x(pg, h5, f9, g6_19);
+        svint64_t h6 = svmul_s64_x(pg, f0, g6);
+        h6 = svmla_s64_x(pg, h6, f1_2, g5);
+        h6 = svmla_s64_x(pg, h6, f2, g4);
+        h6 = svmla_s64_x(pg, h6, f3_2, g3);
+        h6 = svmla_s64_x(pg, h6, f4, g2);
+        h6 = svmla_s64_x(pg, h6, f5_2, g1);
+        h6 = svmla_s64_x(pg, h6, f6, g0);
+        h6 = svmla_s64_x(pg, h6, f7_2, g9_19);
+        h6 = svmla_s64_x(pg, h6, f8, g8_19);
+        h6 = svmla_s64_x(pg, h6, f9_2, g7_19);
+        svint64_t h7 = svmul_s64_x(pg, f0, g7);
+        h7 = svmla_s64_x(pg, h7, f1, g6);
+        h7 = svmla_s64_x(pg, h7, f2, g5);
+        h7 = svmla_s64_x(pg, h7, f3, g4);
+        h7 = svmla_s64_x(pg, h7, f4, g3);
+        h7 = svmla_s64_x(pg, h7, f5, g2);
+        h7 = svmla_s64_x(pg, h7, f6, g1);
+        h7 = svmla_s64_x(pg, h7, f7, g0);
+        h7 = svmla_s64_x(pg, h7, f8, g9_19);
+        h7 = svmla_s64_x(pg, h7, f9, g8_19);
+        svint64_t h8 = svmul_s64_x(pg, f0, g8);
+        h8 = svmla_s64_x(pg, h8, f1_2, g7);
+        h8 = svmla_s64_x(pg, h8, f2, g6);
+        h8 = svmla_s64_x(pg, h8, f3_2, g5);
+        h8 = svmla_s64_x(pg, h8, f4, g4);
+        h8 = svmla_s64_x(pg, h8, f5_2, g3);
+        h8 = svmla_s64_x(pg, h8, f6, g2);
+        h8 = svmla_s64_x(pg, h8, f7_2, g1);
+        h8 = svmla_s64_x(pg, h8, f8, g0);
+        h8 = svmla_s64_x(pg, h8, f9_2, g9_19);
+        svint64_t h9 = svmul_s64_x(pg, f0, g9);
+        h9 = svmla_s64_x(pg, h9, f1, g8);
+        h9 = svmla_s64_x(pg, h9, f2, g7);
+        h9 = svmla_s64_x(pg, h9, f3, g6);
+        h9 = svmla_s64_x(pg, h9, f4, g5);
+        h9 = svmla_s64_x(pg, h9, f5, g4);
+        h9 = svmla_s64_x(pg, h9, f6, g3);
+        h9 = svmla_s64_x(pg, h9, f7, g2);
+        h9 = svmla_s64_x(pg, h9, f8, g1);
+        h9 = svmla_s64_x(pg, h9, f9, g0);
+        vfe_carry_store(pg, h, i, h0, h1, h2, h3, h4, h5, h6, h7, h8, h9);
+    }
+}
+
+/* h = f * f for lanes 0..n-1, see fe_sq */
+static void vfe_sq(vfe h, vfe f, size_t n) {
+    size_t i;
+
+    for (i = 0; i < n; i += svcntd()) {
+        svbool_t pg = svwhilelt_b64_u64(i, n);
+        LOAD10(f, f);
+        svint64_t f0_2 = svadd_s64_x(pg, f0, f0);
+        svint64_t f1_2 = svadd_s64_x(pg, f1, f1);
+        svint64_t f2_2 = svadd_s64_x(pg, f2, f2);
+        svint64_t f3_2 = svadd_s64_x(pg, f3, f3);
+        svint64_t f4_2 = svadd_s64_x(pg, f4, f4);
+        svint64_t f5_2 = svadd_s64_x(pg, f5, f5);
+        svint64_t f6_2 = svadd_s64_x(pg, f6, f6);
+        svint64_t f7_2 = svadd_s64_x(pg, f7, f7);
+        svint64_t f5_38 = svmul_n_s64_x(pg, f5, 38);
+        svint64_t f6_19 = svmul_n_s64_x(pg, f6, 19);
+        svint64_t f7_38 = svmul_n_s64_x(pg, f7, 38);
+        svint64_t f8_19 = svmul_n_s64_x(pg, f8, 19);
+        svint64_t f9_38 = svmul_n_s64_x(pg, f9, 38);
+        svint64_t h0 = svmul_s64_x(pg, f0, f0);
+        h0 = svmla_s64_x(pg, h0, f1_2, f9_38);
+        h0 = svmla_s64_x(pg, h0, f2_2, f8_19);
+        h0 = svmla_s64_x(pg, h0, f3_2, f7_38);
+        h0 = svmla_s64_x(pg, h0, f4_2, f6_19);
+        h0 = svmla_s64_x(pg, h0, f5, f5_38);
+        svint64_t h1 = svmul_s64_x(pg, f0_2, f1);
+        h1 = svmla_s64_x(pg, h1, f2, f9_38);
+        h1 = svmla_s64_x(pg, h1, f3_2, f8_19);
+        h1 = svmla_s64_x(pg, h1, f4, f7_38);
+        h1 = svmla_s64_x(pg, h1, f5_2, f6_19);
+        svint64_t h2 = svmul_s64_x(pg, f0_2, f2);
+        h2 = svmla_s64_x(pg, h2, f1_2, f1);
+        h2 = svmla_s64_x(pg, h2, f3_2, f9_38);
+        h2 = svmla_s64_x(pg, h2, f4_2, f8_19);
+        h2 = svmla_s64_x(pg, h2, f5_2, f7_38);
+        h2 = svmla_s64_x(pg, h2, f6, f6_19);
+        svint64_t h3 = svmul_s64_x(pg, f0_2, f3);
+        h3 = svmla_s64_x(pg, h3, f1_2, f2);
+        h3 = svmla_s64_x(pg, h3, f4, f9_38);
+        h3 = svmla_s64_x(pg, h3, f5_2, f8_19);
+        h3 = svmla_s64_x(pg, h3, f6, f7_38);
+        svint64_t h4 = svmul_s64_x(pg, f0_2, f4);
+        h4 = svmla_s64_x(pg, h4, f1_2, f3_2);
+        h4 = svmla_s64_x(pg, h4, f2, f2);
+        h4 = svmla_s64_x(pg, h4, f5_2, f9_38);
+        h4 = svmla_s64_x(pg, h4, f6_2, f8_19);
+        h4 = svmla_s64_x(pg, h4, f7, f7_38);
+        svint64_t h5 = svmul_s64_x(pg, f0_2, f5);
+        h5 = svmla_s64_x(pg, h5, f1_2, f4);
+        h5 = svmla_s64_x(pg, h5, f2_2, f3);
+        h5 = svmla_s64_x(pg, h5, f6, f9_38);
+        h5 = svmla_s64_x(pg, h5, f7_2, f8_19);
+        svint64_t h6 = svmul_s64_x(pg, f0_2, f6);
+        h6 = svmla_s64_x(pg, h6, f1_2, f5_2);
+        h6 = svmla_s64_x(pg, h6, f2_2, f4);
+        h6 = svmla_s64_x(pg, h6, f3_2, f3);
+        h6 = svmla_s64_x(pg, h6, f7_2, f9_38);
+        h6 = svmla_s64_x(pg, h6, f8, f8_19);
+        svint64_t h7 = svmul_s64_x(pg, f0_2, f7);
+        h7 = svmla_s64_x(pg, h7, f1_2, f6);
+        h7 = svmla_s64_x(pg, h7, f2_2, f5);
+        h7 = svmla_s64_x(pg, h7, f3_2, f4);
+        h7 = svmla_s64_x(pg, h7, f8, f9_38);
+        svint64_t h8 = svmul_s64_x(pg, f0_2, f8);
+        h8 = svmla_s64_x(pg, h8, f1_2, f7_2);
+        h8 = svmla_s64_x(pg, h8, f2_2, f6);
+        h8 = svmla_s64_x(pg, h8, f3_2, f5_2);
+        h8 = svmla_s64_x(pg, h8, f4, f4);
+        h8 = svmla_s64_x(pg, h8, f9, f9_38);
+        svint64_t h9 = svmul_s64_x(pg, f0_2, f9);
+        h9 = svmla_s64_x(pg, h9, f1_2, f8);
+        h9 = svmla_s64_x(pg, h9, f2_2, f7);
+        h9 = svmla_s64_x(pg, h9, f3_2, f6);
+        h9 = svmla_s64_x(pg, h9, f4_2, f5);
+        vfe_carry_store(pg, h, i, h0, h1, h2, h3, h4, h5, h6, h7, h8, h9);
+    }
+}
+
+/* h = f * c for lanes 0..n-1, 0 < c <= 121666 */
+static void vfe_mul_small(vfe h, vfe f, int64_t c, size_t n) {
+    size_t i;
+
+    for (i = 0; i < n; i += svcntd()) {
+        svbool_t pg = svwhilelt_b64_u64(i, n);
+        LOAD10(f, f);
+        vfe_carry_store(pg, h, i,
+            svmul_n_s64_x(pg, f0, c), svmul_n_s64_x(pg, f1, c),
+            svmul_n_s64_x(pg, f2, c), svmul_n_s64_x(pg, f3, c),
+            svmul_n_s64_x(pg, f4, c), svmul_n_s64_x(pg, f5, c),
+            svmul_n_s64_x(pg, f6, c), svmul_n_s64_x(pg, f7, c),
+            svmul_n_s64_x(pg, f8, c), svmul_n_s64_x(pg, f9, c));
+    }
+}
+
+/* swaps f and g in the lanes where mask is -1 (mask is 0 elsewhere) */
+static void vfe_cswap(vfe f, vfe g, const int64_t mask[SVE2_LANES],
+    size_t n)
+{
+    size_t i;
+    int j;
+
+    for (i = 0; i < n; i += svcntd()) {
+        svbool_t pg = svwhilelt_b64_u64(i, n);
+        svint64_t m = svld1_s64(pg, &mask[i]);
+        for (j = 0; j < 10; ++j) {
+            svint64_t a = svld1_s64(pg, &f[j][i]);
+            svint64_t b = svld1_s64(pg, &g[j][i]);
+            svst1_s64(pg, &f[j][i], svbsl_s64(b, a, m));
+            svst1_s64(pg, &g[j][i], svbsl_s64(a, b, m));
+        }
+    }
+}
+
+typedef struct sve2_ladder_state {
+    vfe x1;
+    vfe x2;
+    vfe z2;
+    vfe x3;
+    vfe z3;
+    vfe tmp0;
+    vfe tmp1;
+    int64_t mask[SVE2_LANES];
+    uint8_t e[SVE2_LANES][32];
+} sve2_ladder_state;
+
+/*
+ * Runs n <= SVE2_LANES ladders and writes the projective results to xz
+ * (128 bytes per lane). The base point u = 9 is used if points is NULL.
+ */
+static void ladder_sve2(sve2_ladder_state* s, uint8_t* xz,
+    const uint8_t* keys, const uint8_t* points, size_t n,
+    uint8_t clamp_lo, uint8_t clamp_hi)
+{
+    fe t;
+    size_t l;
+    int j;
+    int pos;
+    int64_t swap[SVE2_LANES];
+
+    for (l = 0; l < n; ++l) {
+        memcpy(s->e[l], keys + 32 * l, 32);
+        s->e[l][0] &= clamp_lo;
+        s->e[l][31] |= clamp_hi;
+        if (points != NULL) {
+            fe_frombytes(t, points + 32 * l);
+        }
+        else {
+            fe_0(t);
+            t[0] = 9;
+        }
+        for (j = 0; j < 10; ++j) {
+            s->x1[j][l] = t[j];
+            s->x2[j][l] = 0;
+            s->z2[j][l] = 0;
+            s->x3[j][l] = t[j];
+            s->z3[j][l] = 0;
+        }
+        s->x2[0][l] = 1;
+        s->z3[0][l] = 1;
+        swap[l] = 0;
+    }
+
+    /* the same sequence as ladder_step in portable/ladder.h */
+    for (pos = 254; pos >= 0; --pos) {
+        for (l = 0; l < n; ++l) {
+            int64_t b = (s->e[l][pos >> 3] >> (pos & 7)) & 1;
+            s->mask[l] = -(swap[l] ^ b);
+            swap[l] = b;
+        }
+        vfe_cswap(s->x2, s->x3, s->mask, n);
+        vfe_cswap(s->z2, s->z3, s->mask, n);
+        vfe_sub(s->tmp0, s->x3, s->z3, n);
+        vfe_sub(s->tmp1, s->x2, s->z2, n);
+        vfe_add(s->x2, s->x2, s->z2, n);
+        vfe_add(s->z2, s->x3, s->z3, n);
+        vfe_mul(s->z3, s->tmp0, s->x2, n);
+        vfe_mul(s->z2, s->z2, s->tmp1, n);
+        vfe_sq(s->tmp0, s->tmp1, n);
+        vfe_sq(s->tmp1, s->x2, n);
+        vfe_add(s->x3, s->z3, s->z2, n);
+        vfe_sub(s->z2, s->z3, s->z2, n);
+        vfe_mul(s->x2, s->tmp1, s->tmp0, n);
+        vfe_sub(s->tmp1, s->tmp1, s->tmp0, n);
+        vfe_sq(s->z2, s->z2, n);
+        vfe_mul_small(s->z3, s->tmp1, 121666, n);
+        vfe_sq(s->x3, s->x3, n);
+        vfe_add(s->tmp0, s->tmp0, s->z3, n);
+        if (points != NULL) {
+            vfe_mul(s->z3, s->x1, s->z2, n);
+        }
+        else {
+            vfe_mul_small(s->z3, s->z2, 9, n);
+        }
+        vfe_mul(s->z2, s->tmp1, s->tmp0, n);
+    }
+    for (l = 0; l < n; ++l) {
+        s->mask[l] = -swap[l];
+    }
+    vfe_cswap(s->x2, s->x3, s->mask, n);
+    vfe_cswap(s->z2, s->z3, s->mask, n);
+
+    for (l = 0; l < n; ++l) {
+        for (j = 0; j < 10; ++j) {
+            t[j] = (int32_t)s->x2[j][l];
+        }
+        fe_tobytes(xz + 128 * l, t);
+        for (j = 0; j < 10; ++j) {
+            t[j] = (int32_t)s->z2[j][l];
+        }
+        fe_tobytes(xz + 128 * l + 32, t);
+        for (j = 0; j < 10; ++j) {
+            t[j] = (int32_t)s->x3[j][l];
+        }
+        fe_tobytes(xz + 128 * l + 64, t);
+        for (j = 0; j < 10; ++j) {
+            t[j] = (int32_t)s->z3[j][l];
+        }
+        fe_tobytes(xz + 128 * l + 96, t);
+    }
+
+    /* remove the private keys */
+    memset(s->e, 0, sizeof(s->e));
+}
+
+/* affine x-coordinate of a single ladder */
+static void scalarmult_sve2(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi)
+{
+    sve2_ladder_state s;
+    uint8_t xz[128];
+    fe x2;
+    fe z2;
+
+    ladder_sve2(&s, xz, n, p, 1, clamp_lo, clamp_hi);
+
+    fe_frombytes(x2, xz);
+    fe_frombytes(z2, xz + 32);
+    fe_invert(z2, z2);
+    fe_mul(x2, x2, z2);
+    fe_tobytes(q, x2);
+}
+
+void mx25519_scalarmult_arm64_sve2(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi)
+{
+    scalarmult_sve2(q, n, p, clamp_lo, clamp_hi);
+}
+
+void mx25519_scalarmult_arm64_sve2_base(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi)
+{
+    (void)p;
+    scalarmult_sve2(q, n, NULL, clamp_lo, clamp_hi);
+}
+
+void mx25519_ladder_arm64_sve2(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi)
+{
+    sve2_ladder_state s;
+
+    ladder_sve2(&s, xz, n, p, 1, clamp_lo, clamp_hi);
+}
+
+void mx25519_ladder_arm64_sve2_base(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi)
+{
+    sve2_ladder_state s;
+
+    (void)p;
+    ladder_sve2(&s, xz, n, NULL, 1, clamp_lo, clamp_hi);
+}
+
+void mx25519_ladder_batch_arm64_sve2(uint8_t* xz,
+    const uint8_t* keys,
+    const uint8_t* points,
+    size_t count,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi)
+{
+    sve2_ladder_state s;
+    size_t n;
+
+    while (count > 0) {
+        n = count < SVE2_LANES ? count : SVE2_LANES;
+        ladder_sve2(&s, xz, keys, points, n, clamp_lo, clamp_hi);
+        xz += 128 * n;
+        keys += 32 * n;
+        points += 32 * n;
+        count -= n;
+    }
+}
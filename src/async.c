@@ -0,0 +1,577 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <mx25519_async.h>
+
+#include <assert.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#define ASYNC_EVENTFD
+#endif
+
+#if defined(__APPLE__)
+/* pthread_condattr_setclock is not available */
+#define ASYNC_CLOCK CLOCK_REALTIME
+#else
+#define ASYNC_CLOCK CLOCK_MONOTONIC
+#endif
+
+#define ASYNC_DEFAULT_QUEUE_SIZE 1024
+#define ASYNC_DEFAULT_MAX_BATCH 64
+#define ASYNC_CACHE_LINE 64
+
+typedef struct async_request {
+    mx25519_privkey key;
+    mx25519_pubkey point;
+    mx25519_async_callback* callback;
+    void* user_data;
+    uint64_t time;
+} async_request;
+
+typedef struct async_slot {
+    atomic_size_t seq;
+    union {
+        async_request req;
+        mx25519_async_completion done;
+    };
+} async_slot;
+
+/*
+ * Bounded MPMC ring (D. Vyukov). Each slot has a sequence number which
+ * tells producers and consumers whether it is free, so the only contended
+ * variables are the head and tail counters.
+ */
+typedef struct async_ring {
+    async_slot* slots;
+    size_t mask;
+    char pad0[ASYNC_CACHE_LINE];
+    atomic_size_t head;
+    char pad1[ASYNC_CACHE_LINE - sizeof(atomic_size_t)];
+    atomic_size_t tail;
+    char pad2[ASYNC_CACHE_LINE - sizeof(atomic_size_t)];
+} async_ring;
+
+typedef struct async_batch {
+    mx25519_privkey* keys;
+    mx25519_pubkey* points;
+    mx25519_pubkey* results;
+    mx25519_async_callback** callbacks;
+    void** user_data;
+} async_batch;
+
+typedef struct async_worker {
+    mx25519_async* ctx;
+    pthread_t thread;
+    async_batch batch;
+} async_worker;
+
+struct mx25519_async {
+    async_ring submit;
+    async_ring complete;
+    const mx25519_impl* impl;
+    unsigned max_batch;
+    uint64_t deadline_ns;
+    bool use_ring;
+    int fd_read;
+    int fd_write;
+    atomic_bool stop;
+    atomic_bool sleeping;
+    atomic_uint running;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    pthread_mutex_t collect_lock;
+    unsigned num_workers;
+    async_worker* workers;
+};
+
+static uint64_t async_now(void) {
+    struct timespec ts;
+    clock_gettime(ASYNC_CLOCK, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void async_wipe(void* ptr, size_t size) {
+    volatile uint8_t* p = ptr;
+    while (size--) {
+        *p++ = 0;
+    }
+}
+
+static bool ring_init(async_ring* ring, size_t size) {
+    size_t i;
+    ring->slots = malloc(size * sizeof(async_slot));
+    if (ring->slots == NULL) {
+        return false;
+    }
+    for (i = 0; i < size; ++i) {
+        atomic_init(&ring->slots[i].seq, i);
+    }
+    ring->mask = size - 1;
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    return true;
+}
+
+static void ring_free(async_ring* ring) {
+    if (ring->slots != NULL) {
+        async_wipe(ring->slots, (ring->mask + 1) * sizeof(async_slot));
+        free(ring->slots);
+    }
+}
+
+/* returns a slot to write into or NULL if the ring is full */
+static async_slot* ring_push_begin(async_ring* ring, size_t* pos) {
+    size_t p = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    for (;;) {
+        async_slot* slot = &ring->slots[p & ring->mask];
+        size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)p;
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&ring->head, &p, p + 1,
+                memory_order_relaxed, memory_order_relaxed)) {
+                *pos = p;
+                return slot;
+            }
+        }
+        else if (diff < 0) {
+            return NULL;
+        }
+        else {
+            p = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        }
+    }
+}
+
+static void ring_push_end(async_slot* slot, size_t pos) {
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+}
+
+/* returns a slot to read from or NULL if the ring is empty */
+static async_slot* ring_pop_begin(async_ring* ring, size_t* pos) {
+    size_t p = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    for (;;) {
+        async_slot* slot = &ring->slots[p & ring->mask];
+        size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(p + 1);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&ring->tail, &p, p + 1,
+                memory_order_relaxed, memory_order_relaxed)) {
+                *pos = p;
+                return slot;
+            }
+        }
+        else if (diff < 0) {
+            return NULL;
+        }
+        else {
+            p = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        }
+    }
+}
+
+static void ring_pop_end(async_ring* ring, async_slot* slot, size_t pos) {
+    atomic_store_explicit(&slot->seq, pos + ring->mask + 1,
+        memory_order_release);
+}
+
+static bool ring_empty(async_ring* ring) {
+    size_t p = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    async_slot* slot = &ring->slots[p & ring->mask];
+    size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+    return (intptr_t)seq - (intptr_t)(p + 1) < 0;
+}
+
+static bool async_pop_request(mx25519_async* ctx, async_batch* batch,
+    size_t i, uint64_t* time)
+{
+    size_t pos;
+    async_slot* slot = ring_pop_begin(&ctx->submit, &pos);
+    if (slot == NULL) {
+        return false;
+    }
+    batch->keys[i] = slot->req.key;
+    batch->points[i] = slot->req.point;
+    batch->callbacks[i] = slot->req.callback;
+    batch->user_data[i] = slot->req.user_data;
+    *time = slot->req.time;
+    async_wipe(&slot->req.key, sizeof(slot->req.key));
+    ring_pop_end(&ctx->submit, slot, pos);
+    return true;
+}
+
+/*
+ * Sleeps until a request is submitted, the instance is stopped or the
+ * deadline (if non-zero) expires. Only the collecting worker sleeps here.
+ */
+static void async_wait(mx25519_async* ctx, uint64_t deadline) {
+    pthread_mutex_lock(&ctx->lock);
+    atomic_store(&ctx->sleeping, true);
+    atomic_thread_fence(memory_order_seq_cst);
+    if (ring_empty(&ctx->submit) && !atomic_load(&ctx->stop)) {
+        if (deadline != 0) {
+            struct timespec ts;
+            ts.tv_sec = deadline / 1000000000;
+            ts.tv_nsec = deadline % 1000000000;
+            pthread_cond_timedwait(&ctx->cond, &ctx->lock, &ts);
+        }
+        else {
+            pthread_cond_wait(&ctx->cond, &ctx->lock);
+        }
+    }
+    atomic_store(&ctx->sleeping, false);
+    pthread_mutex_unlock(&ctx->lock);
+}
+
+static void async_wake(mx25519_async* ctx) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load(&ctx->sleeping)) {
+        pthread_mutex_lock(&ctx->lock);
+        pthread_cond_signal(&ctx->cond);
+        pthread_mutex_unlock(&ctx->lock);
+    }
+}
+
+/*
+ * Fills a batch. Only one worker collects at a time, so requests are not
+ * split between partially filled batches. Returns 0 when the instance is
+ * stopped and there are no pending requests.
+ */
+static size_t async_collect(mx25519_async* ctx, async_batch* batch) {
+    size_t count = 0;
+    uint64_t deadline = 0;
+    uint64_t time;
+
+    for (;;) {
+        while (count < ctx->max_batch
+            && async_pop_request(ctx, batch, count, &time)) {
+            if (count == 0) {
+                deadline = time + ctx->deadline_ns;
+            }
+            ++count;
+        }
+        if (count == ctx->max_batch) {
+            return count;
+        }
+        if (atomic_load(&ctx->stop)) {
+            return count;
+        }
+        if (count > 0 && async_now() >= deadline) {
+            return count;
+        }
+        async_wait(ctx, count > 0 ? deadline : 0);
+    }
+}
+
+static void async_notify(mx25519_async* ctx, size_t count) {
+#ifdef ASYNC_EVENTFD
+    uint64_t value = count;
+    ssize_t res = write(ctx->fd_write, &value, sizeof(value));
+#else
+    uint8_t value = 1;
+    ssize_t res = write(ctx->fd_write, &value, sizeof(value));
+#endif
+    /* EAGAIN: the descriptor is already readable */
+    (void)res;
+}
+
+static void async_complete(mx25519_async* ctx, async_batch* batch,
+    size_t count)
+{
+    size_t i, pos;
+
+    if (!ctx->use_ring) {
+        for (i = 0; i < count; ++i) {
+            batch->callbacks[i](batch->user_data[i], &batch->results[i]);
+        }
+        return;
+    }
+    for (i = 0; i < count; ++i) {
+        async_slot* slot;
+        while ((slot = ring_push_begin(&ctx->complete, &pos)) == NULL) {
+            /* the consumer is not keeping up */
+            async_notify(ctx, 1);
+            sched_yield();
+        }
+        slot->done.result = batch->results[i];
+        slot->done.user_data = batch->user_data[i];
+        ring_push_end(slot, pos);
+    }
+    async_notify(ctx, count);
+}
+
+static void* async_worker_main(void* arg) {
+    async_worker* worker = arg;
+    mx25519_async* ctx = worker->ctx;
+    async_batch* batch = &worker->batch;
+    size_t count;
+
+    for (;;) {
+        pthread_mutex_lock(&ctx->collect_lock);
+        count = async_collect(ctx, batch);
+        pthread_mutex_unlock(&ctx->collect_lock);
+        if (count == 0) {
+            break;
+        }
+        mx25519_scmul_key_batch(ctx->impl, batch->results, batch->keys,
+            batch->points, count);
+        async_wipe(batch->keys, count * sizeof(mx25519_privkey));
+        async_complete(ctx, batch, count);
+    }
+    atomic_fetch_sub(&ctx->running, 1);
+    return NULL;
+}
+
+static bool batch_alloc(async_batch* batch, size_t size) {
+    batch->keys = malloc(size * sizeof(mx25519_privkey));
+    batch->points = malloc(size * sizeof(mx25519_pubkey));
+    batch->results = malloc(size * sizeof(mx25519_pubkey));
+    batch->callbacks = malloc(size * sizeof(mx25519_async_callback*));
+    batch->user_data = malloc(size * sizeof(void*));
+    return batch->keys != NULL && batch->points != NULL
+        && batch->results != NULL && batch->callbacks != NULL
+        && batch->user_data != NULL;
+}
+
+static void batch_free(async_batch* batch, size_t size) {
+    if (batch->keys != NULL) {
+        async_wipe(batch->keys, size * sizeof(mx25519_privkey));
+    }
+    free(batch->keys);
+    free(batch->points);
+    free(batch->results);
+    free(batch->callbacks);
+    free(batch->user_data);
+}
+
+static bool async_open_fd(mx25519_async* ctx) {
+#ifdef ASYNC_EVENTFD
+    ctx->fd_read = ctx->fd_write = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    return ctx->fd_read >= 0;
+#else
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return false;
+    }
+    ctx->fd_read = fds[0];
+    ctx->fd_write = fds[1];
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+    fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return true;
+#endif
+}
+
+static void async_close_fd(mx25519_async* ctx) {
+    if (ctx->fd_read >= 0) {
+        close(ctx->fd_read);
+    }
+    if (ctx->fd_write >= 0 && ctx->fd_write != ctx->fd_read) {
+        close(ctx->fd_write);
+    }
+}
+
+static void async_drain_fd(mx25519_async* ctx) {
+#ifdef ASYNC_EVENTFD
+    uint64_t value;
+    ssize_t res = read(ctx->fd_read, &value, sizeof(value));
+    (void)res;
+#else
+    uint8_t buffer[64];
+    while (read(ctx->fd_read, buffer, sizeof(buffer)) > 0) {
+    }
+#endif
+}
+
+static size_t round_pow2(size_t size) {
+    size_t pow2 = 2;
+    while (pow2 < size) {
+        pow2 <<= 1;
+    }
+    return pow2;
+}
+
+static void async_free(mx25519_async* ctx) {
+    unsigned i;
+    if (ctx->workers != NULL) {
+        for (i = 0; i < ctx->num_workers; ++i) {
+            batch_free(&ctx->workers[i].batch, ctx->max_batch);
+        }
+        free(ctx->workers);
+    }
+    async_close_fd(ctx);
+    ring_free(&ctx->submit);
+    ring_free(&ctx->complete);
+    pthread_cond_destroy(&ctx->cond);
+    pthread_mutex_destroy(&ctx->lock);
+    pthread_mutex_destroy(&ctx->collect_lock);
+    free(ctx);
+}
+
+/* signals the workers to stop and waits for them to exit */
+static void async_stop(mx25519_async* ctx, unsigned started) {
+    mx25519_async_completion discard[64];
+    unsigned i;
+
+    atomic_store(&ctx->stop, true);
+    pthread_mutex_lock(&ctx->lock);
+    pthread_cond_broadcast(&ctx->cond);
+    pthread_mutex_unlock(&ctx->lock);
+    if (ctx->use_ring) {
+        /* workers may be blocked on a full completion ring */
+        while (atomic_load(&ctx->running) > 0) {
+            if (mx25519_async_poll(ctx, discard, 64) == 0) {
+                sched_yield();
+            }
+        }
+    }
+    for (i = 0; i < started; ++i) {
+        pthread_join(ctx->workers[i].thread, NULL);
+    }
+}
+
+mx25519_async* mx25519_async_create(const mx25519_async_config* config)
+{
+    mx25519_async* ctx;
+    pthread_condattr_t cond_attr;
+    size_t queue_size;
+    unsigned i;
+
+    assert(config != NULL);
+    assert(config->impl != NULL);
+
+    ctx = calloc(1, sizeof(mx25519_async));
+    if (ctx == NULL) {
+        return NULL;
+    }
+    ctx->impl = config->impl;
+    ctx->max_batch = config->max_batch ? config->max_batch
+        : ASYNC_DEFAULT_MAX_BATCH;
+    ctx->deadline_ns = (uint64_t)config->deadline_us * 1000;
+    ctx->use_ring = config->completion_ring != 0;
+    ctx->num_workers = config->threads ? config->threads : 1;
+    ctx->fd_read = ctx->fd_write = -1;
+    atomic_init(&ctx->stop, false);
+    atomic_init(&ctx->sleeping, false);
+    atomic_init(&ctx->running, 0);
+    pthread_mutex_init(&ctx->lock, NULL);
+    pthread_mutex_init(&ctx->collect_lock, NULL);
+    pthread_condattr_init(&cond_attr);
+#if !defined(__APPLE__)
+    pthread_condattr_setclock(&cond_attr, ASYNC_CLOCK);
+#endif
+    pthread_cond_init(&ctx->cond, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+
+    queue_size = round_pow2(config->queue_size ? config->queue_size
+        : ASYNC_DEFAULT_QUEUE_SIZE);
+    if (!ring_init(&ctx->submit, queue_size)) {
+        goto fail;
+    }
+    if (ctx->use_ring) {
+        if (!ring_init(&ctx->complete, queue_size) || !async_open_fd(ctx)) {
+            goto fail;
+        }
+    }
+    ctx->workers = calloc(ctx->num_workers, sizeof(async_worker));
+    if (ctx->workers == NULL) {
+        goto fail;
+    }
+    for (i = 0; i < ctx->num_workers; ++i) {
+        ctx->workers[i].ctx = ctx;
+        if (!batch_alloc(&ctx->workers[i].batch, ctx->max_batch)) {
+            goto fail;
+        }
+    }
+    for (i = 0; i < ctx->num_workers; ++i) {
+        atomic_fetch_add(&ctx->running, 1);
+        if (pthread_create(&ctx->workers[i].thread, NULL, &async_worker_main,
+            &ctx->workers[i]) != 0) {
+            atomic_fetch_sub(&ctx->running, 1);
+            async_stop(ctx, i);
+            goto fail;
+        }
+    }
+    return ctx;
+
+fail:
+    async_free(ctx);
+    return NULL;
+}
+
+void mx25519_async_destroy(mx25519_async* ctx)
+{
+    if (ctx == NULL) {
+        return;
+    }
+    async_stop(ctx, ctx->num_workers);
+    async_free(ctx);
+}
+
+int mx25519_async_submit(mx25519_async* ctx, const mx25519_privkey* key,
+    const mx25519_pubkey* p, mx25519_async_callback* callback,
+    void* user_data)
+{
+    async_slot* slot;
+    size_t pos;
+
+    assert(ctx != NULL);
+    assert(key != NULL);
+    assert(p != NULL);
+    assert(ctx->use_ring || callback != NULL);
+
+    slot = ring_push_begin(&ctx->submit, &pos);
+    if (slot == NULL) {
+        return -1;
+    }
+    slot->req.key = *key;
+    slot->req.point = *p;
+    slot->req.callback = callback;
+    slot->req.user_data = user_data;
+    slot->req.time = async_now();
+    ring_push_end(slot, pos);
+    async_wake(ctx);
+    return 0;
+}
+
+int mx25519_async_fd(const mx25519_async* ctx)
+{
+    assert(ctx != NULL);
+    return ctx->fd_read;
+}
+
+size_t mx25519_async_poll(mx25519_async* ctx, mx25519_async_completion* out,
+    size_t max)
+{
+    size_t count = 0, pos;
+    async_slot* slot;
+
+    assert(ctx != NULL);
+    assert(ctx->use_ring);
+
+    /* clear the descriptor first, so that no notification is lost */
+    async_drain_fd(ctx);
+    while (count < max
+        && (slot = ring_pop_begin(&ctx->complete, &pos)) != NULL) {
+        out[count++] = slot->done;
+        ring_pop_end(&ctx->complete, slot, pos);
+    }
+    return count;
+}
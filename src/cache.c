@@ -0,0 +1,535 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <mx25519_cache.h>
+
+#include "platform.h"
+#include "trace.h"
+
+#include <assert.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+#define CACHE_DEFAULT_CAPACITY 4096
+#define CACHE_DEFAULT_SHARDS 16
+#define CACHE_DEFAULT_MAX_KEYS 4
+#define CACHE_LINE_SIZE 64
+#define CACHE_NONE UINT32_MAX
+#define CACHE_KEY_SIZE 32
+
+/*
+ * Entries live in locked memory. The links are indices into the entries of
+ * the same shard.
+ */
+typedef struct cache_entry {
+    mx25519_pubkey peer;
+    mx25519_pubkey secret;
+    uint32_t key;    /* handle of the local key */
+    uint32_t gen;    /* generation of the local key */
+    uint32_t prev;   /* towards the most recently used entry */
+    uint32_t next;   /* towards the least recently used entry */
+    uint32_t chain;  /* next entry in the same bucket */
+    uint32_t bucket; /* CACHE_NONE for free entries */
+} cache_entry;
+
+typedef struct cache_shard {
+    pthread_mutex_t lock;
+    cache_entry* entries;
+    uint32_t* buckets;
+    uint32_t head; /* most recently used */
+    uint32_t tail; /* least recently used */
+    uint32_t free; /* free entries linked by `next` */
+    char pad[CACHE_LINE_SIZE];
+} cache_shard;
+
+struct mx25519_cache {
+    const mx25519_impl* impl;
+    uint64_t hash_key[2];
+    void* locked;
+    size_t locked_size;
+    mx25519_privkey* keys;  /* in locked memory */
+    atomic_uint* gens;      /* odd if the key is registered */
+    unsigned max_keys;
+    pthread_mutex_t keys_lock;
+    unsigned shard_mask;
+    uint32_t shard_size;
+    uint32_t bucket_mask;
+    uint32_t* buckets;
+    cache_shard* shards;
+};
+
+static void cache_wipe(void* ptr, size_t size) {
+    volatile uint8_t* p = ptr;
+    while (size--) {
+        *p++ = 0;
+    }
+}
+
+/* constant time */
+static bool cache_equal(const mx25519_pubkey* a, const mx25519_pubkey* b) {
+    uint8_t diff = 0;
+    int i;
+    for (i = 0; i < CACHE_KEY_SIZE; ++i) {
+        diff |= a->data[i] ^ b->data[i];
+    }
+    return diff == 0;
+}
+
+#define ROTL(x, b) (((x) << (b)) | ((x) >> (64 - (b))))
+
+#define SIPROUND                                            \
+    do {                                                    \
+        v0 += v1; v1 = ROTL(v1, 13); v1 ^= v0;              \
+        v0 = ROTL(v0, 32);                                  \
+        v2 += v3; v3 = ROTL(v3, 16); v3 ^= v2;              \
+        v0 += v3; v3 = ROTL(v3, 21); v3 ^= v0;              \
+        v2 += v1; v1 = ROTL(v1, 17); v1 ^= v2;              \
+        v2 = ROTL(v2, 32);                                  \
+    } while (0)
+
+/*
+ * SipHash-1-3 of the peer key with a random key, so that peers cannot
+ * choose keys which collide in one bucket.
+ */
+static uint64_t cache_hash(const mx25519_cache* cache,
+    const mx25519_pubkey* p)
+{
+    uint64_t v0 = cache->hash_key[0] ^ 0x736f6d6570736575ull;
+    uint64_t v1 = cache->hash_key[1] ^ 0x646f72616e646f6dull;
+    uint64_t v2 = cache->hash_key[0] ^ 0x6c7967656e657261ull;
+    uint64_t v3 = cache->hash_key[1] ^ 0x7465646279746573ull;
+    uint64_t m;
+    int i;
+
+    for (i = 0; i < CACHE_KEY_SIZE; i += 8) {
+        m = platform_load64(&p->data[i]);
+        v3 ^= m;
+        SIPROUND;
+        v0 ^= m;
+    }
+    m = (uint64_t)CACHE_KEY_SIZE << 56;
+    v3 ^= m;
+    SIPROUND;
+    v0 ^= m;
+    v2 ^= 0xff;
+    SIPROUND;
+    SIPROUND;
+    SIPROUND;
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+/* returns false if the random hash key could not be read */
+static bool cache_seed(mx25519_cache* cache) {
+    ssize_t res = -1;
+    int fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        res = read(fd, cache->hash_key, sizeof(cache->hash_key));
+        close(fd);
+    }
+    return res == (ssize_t)sizeof(cache->hash_key);
+}
+
+static void* cache_alloc_locked(size_t size, bool allow_unlocked) {
+    void* ptr = mmap(NULL, size, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+        return NULL;
+    }
+#ifdef MADV_DONTDUMP
+    madvise(ptr, size, MADV_DONTDUMP);
+#endif
+    if (mlock(ptr, size) != 0 && !allow_unlocked) {
+        munmap(ptr, size);
+        return NULL;
+    }
+    return ptr;
+}
+
+static void cache_free_locked(void* ptr, size_t size) {
+    cache_wipe(ptr, size);
+    munlock(ptr, size);
+    munmap(ptr, size);
+}
+
+static uint32_t round_pow2(uint32_t size) {
+    uint32_t pow2 = 1;
+    while (pow2 < size) {
+        pow2 <<= 1;
+    }
+    return pow2;
+}
+
+static void lru_unlink(cache_shard* shard, cache_entry* e) {
+    if (e->prev != CACHE_NONE) {
+        shard->entries[e->prev].next = e->next;
+    }
+    else {
+        shard->head = e->next;
+    }
+    if (e->next != CACHE_NONE) {
+        shard->entries[e->next].prev = e->prev;
+    }
+    else {
+        shard->tail = e->prev;
+    }
+}
+
+static void lru_push_front(cache_shard* shard, uint32_t i) {
+    cache_entry* e = &shard->entries[i];
+    e->prev = CACHE_NONE;
+    e->next = shard->head;
+    if (shard->head != CACHE_NONE) {
+        shard->entries[shard->head].prev = i;
+    }
+    else {
+        shard->tail = i;
+    }
+    shard->head = i;
+}
+
+/* wipes an entry and moves it to the free list */
+static void entry_remove(cache_shard* shard, uint32_t i) {
+    cache_entry* e = &shard->entries[i];
+    uint32_t* link = &shard->buckets[e->bucket];
+    while (*link != i) {
+        link = &shard->entries[*link].chain;
+    }
+    *link = e->chain;
+    lru_unlink(shard, e);
+    cache_wipe(e, sizeof(cache_entry));
+    e->bucket = CACHE_NONE;
+    e->next = shard->free;
+    shard->free = i;
+}
+
+static void shard_reset(cache_shard* shard, uint32_t size,
+    uint32_t buckets)
+{
+    uint32_t i;
+    cache_wipe(shard->entries, size * sizeof(cache_entry));
+    for (i = 0; i < size; ++i) {
+        shard->entries[i].bucket = CACHE_NONE;
+        shard->entries[i].next = i + 1 < size ? i + 1 : CACHE_NONE;
+    }
+    for (i = 0; i < buckets; ++i) {
+        shard->buckets[i] = CACHE_NONE;
+    }
+    shard->head = shard->tail = CACHE_NONE;
+    shard->free = 0;
+}
+
+static uint32_t shard_find(cache_shard* shard, uint32_t bucket,
+    uint32_t key, uint32_t gen, const mx25519_pubkey* p)
+{
+    uint32_t i = shard->buckets[bucket];
+    while (i != CACHE_NONE) {
+        cache_entry* e = &shard->entries[i];
+        if (cache_equal(&e->peer, p) & (e->key == key) & (e->gen == gen)) {
+            return i;
+        }
+        i = e->chain;
+    }
+    return CACHE_NONE;
+}
+
+static void shard_insert(cache_shard* shard, uint32_t bucket, uint32_t key,
+    uint32_t gen, const mx25519_pubkey* p, const mx25519_pubkey* secret)
+{
+    cache_entry* e;
+    uint32_t i = shard_find(shard, bucket, key, gen, p);
+    if (i != CACHE_NONE) {
+        /* inserted by another thread in the meantime */
+        lru_unlink(shard, &shard->entries[i]);
+        lru_push_front(shard, i);
+        return;
+    }
+    if (shard->free == CACHE_NONE) {
+        entry_remove(shard, shard->tail);
+    }
+    i = shard->free;
+    e = &shard->entries[i];
+    shard->free = e->next;
+    e->peer = *p;
+    e->secret = *secret;
+    e->key = key;
+    e->gen = gen;
+    e->bucket = bucket;
+    e->chain = shard->buckets[bucket];
+    shard->buckets[bucket] = i;
+    lru_push_front(shard, i);
+}
+
+/* removes the entries of a local key from all shards */
+static void cache_remove_entries(mx25519_cache* cache, uint32_t key) {
+    unsigned s;
+    for (s = 0; s <= cache->shard_mask; ++s) {
+        cache_shard* shard = &cache->shards[s];
+        uint32_t i, next;
+        pthread_mutex_lock(&shard->lock);
+        for (i = shard->head; i != CACHE_NONE; i = next) {
+            next = shard->entries[i].next;
+            if (shard->entries[i].key == key) {
+                entry_remove(shard, i);
+            }
+        }
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
+
+static void cache_free(mx25519_cache* cache, unsigned shards) {
+    unsigned s;
+    for (s = 0; s < shards; ++s) {
+        pthread_mutex_destroy(&cache->shards[s].lock);
+    }
+    if (cache->locked != NULL) {
+        cache_free_locked(cache->locked, cache->locked_size);
+    }
+    pthread_mutex_destroy(&cache->keys_lock);
+    free(cache->gens);
+    free(cache->buckets);
+    free(cache->shards);
+    free(cache);
+}
+
+mx25519_cache* mx25519_cache_create(const mx25519_cache_config* config)
+{
+    mx25519_cache* cache;
+    size_t capacity, entries_size;
+    unsigned shards, s;
+    uint32_t num_buckets;
+
+    assert(config != NULL);
+    assert(config->impl != NULL);
+
+    capacity = config->capacity ? config->capacity : CACHE_DEFAULT_CAPACITY;
+    /* round_pow2 would overflow */
+    if (config->shards > (1u << 31) || capacity > UINT32_MAX) {
+        return NULL;
+    }
+    shards = round_pow2(config->shards ? config->shards
+        : CACHE_DEFAULT_SHARDS);
+    if (shards > capacity) {
+        shards = round_pow2((uint32_t)capacity);
+        if (shards > capacity) {
+            shards >>= 1;
+        }
+    }
+    if (capacity / shards >= CACHE_NONE / 2) {
+        return NULL;
+    }
+
+    cache = calloc(1, sizeof(mx25519_cache));
+    if (cache == NULL) {
+        return NULL;
+    }
+    cache->impl = config->impl;
+    cache->max_keys = config->max_keys ? config->max_keys
+        : CACHE_DEFAULT_MAX_KEYS;
+    cache->shard_mask = shards - 1;
+    cache->shard_size = (uint32_t)((capacity + shards - 1) / shards);
+    num_buckets = round_pow2(cache->shard_size);
+    cache->bucket_mask = num_buckets - 1;
+    /* a predictable hash key would let peers flood one bucket chain */
+    if (!cache_seed(cache)) {
+        cache_wipe(cache, sizeof(mx25519_cache));
+        free(cache);
+        return NULL;
+    }
+    pthread_mutex_init(&cache->keys_lock, NULL);
+
+    /* the secrets and the local keys share one locked mapping */
+    entries_size = (size_t)shards * cache->shard_size * sizeof(cache_entry);
+    cache->locked_size = entries_size
+        + cache->max_keys * sizeof(mx25519_privkey);
+    cache->locked = cache_alloc_locked(cache->locked_size,
+        config->allow_unlocked != 0);
+    cache->gens = calloc(cache->max_keys, sizeof(atomic_uint));
+    cache->buckets = malloc((size_t)shards * num_buckets * sizeof(uint32_t));
+    cache->shards = calloc(shards, sizeof(cache_shard));
+    if (cache->locked == NULL || cache->gens == NULL
+        || cache->buckets == NULL || cache->shards == NULL) {
+        cache_free(cache, 0);
+        return NULL;
+    }
+    cache->keys = (mx25519_privkey*)((uint8_t*)cache->locked + entries_size);
+    for (s = 0; s < cache->max_keys; ++s) {
+        atomic_init(&cache->gens[s], 0);
+    }
+    for (s = 0; s < shards; ++s) {
+        cache_shard* shard = &cache->shards[s];
+        pthread_mutex_init(&shard->lock, NULL);
+        shard->entries = (cache_entry*)cache->locked + s * cache->shard_size;
+        shard->buckets = &cache->buckets[s * num_buckets];
+        shard_reset(shard, cache->shard_size, num_buckets);
+    }
+    return cache;
+}
+
+void mx25519_cache_destroy(mx25519_cache* cache)
+{
+    if (cache == NULL) {
+        return;
+    }
+    cache_free(cache, cache->shard_mask + 1);
+}
+
+int mx25519_cache_add_key(mx25519_cache* cache, const mx25519_privkey* key)
+{
+    unsigned i;
+    int handle = -1;
+
+    assert(cache != NULL);
+    assert(key != NULL);
+
+    pthread_mutex_lock(&cache->keys_lock);
+    for (i = 0; i < cache->max_keys; ++i) {
+        unsigned gen = atomic_load(&cache->gens[i]);
+        if ((gen & 1) == 0) {
+            cache->keys[i] = *key;
+            atomic_store(&cache->gens[i], gen + 1);
+            handle = (int)i;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&cache->keys_lock);
+    return handle;
+}
+
+void mx25519_cache_remove_key(mx25519_cache* cache, int handle)
+{
+    unsigned gen;
+
+    assert(cache != NULL);
+    assert(handle >= 0 && (unsigned)handle < cache->max_keys);
+
+    pthread_mutex_lock(&cache->keys_lock);
+    gen = atomic_load(&cache->gens[handle]);
+    if ((gen & 1) == 0) {
+        pthread_mutex_unlock(&cache->keys_lock);
+        return;
+    }
+    cache_wipe(&cache->keys[handle], sizeof(mx25519_privkey));
+    /* from now on, the old entries don't match and can't be inserted */
+    atomic_store(&cache->gens[handle], gen + 1);
+    pthread_mutex_unlock(&cache->keys_lock);
+    cache_remove_entries(cache, (uint32_t)handle);
+}
+
+int mx25519_cache_scmul_key(mx25519_cache* cache, mx25519_pubkey* result,
+    int handle, const mx25519_pubkey* p)
+{
+    mx25519_privkey key;
+    mx25519_pubkey peer, secret;
+    cache_shard* shard;
+    uint64_t hash;
+    uint32_t bucket, i;
+    unsigned gen;
+
+    assert(cache != NULL);
+    assert(result != NULL);
+    assert(p != NULL);
+
+    if (handle < 0 || (unsigned)handle >= cache->max_keys) {
+        return -1;
+    }
+    gen = atomic_load(&cache->gens[handle]);
+    if ((gen & 1) == 0) {
+        return -1;
+    }
+    /* result may alias p */
+    peer = *p;
+    hash = cache_hash(cache, &peer);
+    shard = &cache->shards[hash & cache->shard_mask];
+    bucket = (uint32_t)(hash >> 32) & cache->bucket_mask;
+
+    pthread_mutex_lock(&shard->lock);
+    i = shard_find(shard, bucket, (uint32_t)handle, gen, &peer);
+    if (i != CACHE_NONE) {
+        *result = shard->entries[i].secret;
+        lru_unlink(shard, &shard->entries[i]);
+        lru_push_front(shard, i);
+        pthread_mutex_unlock(&shard->lock);
+        TRACE_PROBE1(cache__hit, handle);
+        return 1;
+    }
+    pthread_mutex_unlock(&shard->lock);
+    TRACE_PROBE1(cache__miss, handle);
+
+    pthread_mutex_lock(&cache->keys_lock);
+    if (atomic_load(&cache->gens[handle]) != gen) {
+        pthread_mutex_unlock(&cache->keys_lock);
+        return -1;
+    }
+    key = cache->keys[handle];
+    pthread_mutex_unlock(&cache->keys_lock);
+
+    mx25519_scmul_key(cache->impl, &secret, &key, &peer);
+    cache_wipe(&key, sizeof(key));
+
+    pthread_mutex_lock(&shard->lock);
+    if (atomic_load(&cache->gens[handle]) == gen) {
+        shard_insert(shard, bucket, (uint32_t)handle, gen, &peer, &secret);
+    }
+    pthread_mutex_unlock(&shard->lock);
+    *result = secret;
+    cache_wipe(&secret, sizeof(secret));
+    return 0;
+}
+
+size_t mx25519_cache_invalidate(mx25519_cache* cache, const mx25519_pubkey* p)
+{
+    cache_shard* shard;
+    uint64_t hash;
+    uint32_t bucket, i, next;
+    size_t count = 0;
+
+    assert(cache != NULL);
+    assert(p != NULL);
+
+    hash = cache_hash(cache, p);
+    shard = &cache->shards[hash & cache->shard_mask];
+    bucket = (uint32_t)(hash >> 32) & cache->bucket_mask;
+
+    pthread_mutex_lock(&shard->lock);
+    for (i = shard->buckets[bucket]; i != CACHE_NONE; i = next) {
+        next = shard->entries[i].chain;
+        if (cache_equal(&shard->entries[i].peer, p)) {
+            entry_remove(shard, i);
+            ++count;
+        }
+    }
+    pthread_mutex_unlock(&shard->lock);
+    return count;
+}
+
+void mx25519_cache_clear(mx25519_cache* cache)
+{
+    unsigned s;
+
+    assert(cache != NULL);
+
+    for (s = 0; s <= cache->shard_mask; ++s) {
+        cache_shard* shard = &cache->shards[s];
+        pthread_mutex_lock(&shard->lock);
+        shard_reset(shard, cache->shard_size, cache->bucket_mask + 1);
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
@@ -20,6 +20,71 @@ static void cpuid(uint32_t info[4], uint32_t type) {
 #endif
 #endif
 
+#if defined(PLATFORM_ARM64) && defined(__linux__)
+#define HAVE_MIDR
+#include <sys/auxv.h>
+#ifndef HWCAP_CPUID
+#define HWCAP_CPUID (1 << 11)
+#endif
+#ifndef AT_HWCAP2
+#define AT_HWCAP2 26
+#endif
+#ifndef HWCAP2_SVE2
+#define HWCAP2_SVE2 (1 << 1)
+#endif
+
+/* MIDR_EL1 part numbers of ARM cores with at least 2 scalar multipliers */
+static const uint16_t arm_wide_parts[] = {
+    0xd0b, /* Cortex-A76 */
+    0xd0c, /* Neoverse N1 */
+    0xd0d, /* Cortex-A77 */
+    0xd40, /* Neoverse V1 */
+    0xd41, /* Cortex-A78 */
+    0xd44, /* Cortex-X1 */
+    0xd47, /* Cortex-A710 */
+    0xd48, /* Cortex-X2 */
+    0xd49, /* Neoverse N2 */
+    0xd4d, /* Cortex-A715 */
+    0xd4e, /* Cortex-X3 */
+    0xd4f, /* Neoverse V2 */
+    0xd81, /* Cortex-A720 */
+    0xd82, /* Cortex-X4 */
+    0xd84, /* Neoverse V3 */
+    0xd85, /* Cortex-X925 */
+    0xd87, /* Cortex-A725 */
+};
+
+/*
+ * Reads MIDR_EL1 of the current core. The kernel traps and emulates the
+ * access when HWCAP_CPUID is set. On big.LITTLE systems, the result depends
+ * on the core the thread happens to run on.
+ */
+static bool arm64_wide_mul(void) {
+    uint64_t midr;
+    uint32_t implementer, part;
+    size_t i;
+
+    if ((getauxval(AT_HWCAP) & HWCAP_CPUID) == 0) {
+        return false;
+    }
+    __asm__ volatile("mrs %0, midr_el1" : "=r"(midr));
+    implementer = (midr >> 24) & 0xff;
+    part = (midr >> 4) & 0xfff;
+    if (implementer == 0x61 || implementer == 0xc0) {
+        /* Apple, Ampere */
+        return true;
+    }
+    if (implementer == 0x41) {
+        for (i = 0; i < sizeof(arm_wide_parts) / sizeof(arm_wide_parts[0]); ++i) {
+            if (part == arm_wide_parts[i]) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+#endif
+
 x25519_cpu_cap mx25519_get_cpu_cap() {
     static x25519_cpu_cap cap = -1;
     if (cap == -1) {
@@ -54,6 +119,16 @@ x25519_cpu_cap mx25519_get_cpu_cap() {
                 cap |= X25519_CPU_CAP_RDTSCP;
             }
         }
+#endif
+#if defined(PLATFORM_ARM64) && defined(__APPLE__)
+        cap |= X25519_CPU_CAP_WIDE_MUL;
+#elif defined(HAVE_MIDR)
+        if (arm64_wide_mul()) {
+            cap |= X25519_CPU_CAP_WIDE_MUL;
+        }
+        if (getauxval(AT_HWCAP2) & HWCAP2_SVE2) {
+            cap |= X25519_CPU_CAP_SVE2;
+        }
 #endif
     }
     return cap;
@@ -13,6 +13,8 @@ typedef enum x25519_cpu_cap {
     X25519_CPU_CAP_AVX2 = 4,
     X25519_CPU_CAP_MULX = 8,
     X25519_CPU_CAP_ADX = 16,
+    X25519_CPU_CAP_WIDE_MUL = 32, /* wide ARM64 core with fast mul/umulh */
+    X25519_CPU_CAP_SVE2 = 64,
 } x25519_cpu_cap;
 
 x25519_cpu_cap mx25519_get_cpu_cap(void);
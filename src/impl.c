@@ -8,6 +8,15 @@
 
 #include "impl.h"
 #include "platform.h"
+
+#ifdef MX25519_FORCE_IMPL
+
+const mx25519_impl mx25519_impl_forced = {
+    .type = MX25519_FORCE_IMPL
+};
+
+#else
+
 #include "portable/scalarmult.h"
 #ifdef PLATFORM_ARM64
 #include "arm64/scalarmult.h"
@@ -18,14 +27,25 @@
 
 static const mx25519_impl impl_portable = {
     .scmul = &mx25519_scalarmult_portable,
+    .scmul_base = &mx25519_scalarmult_portable_base,
+    .ladder = &mx25519_ladder_portable,
+    .ladder_base = &mx25519_ladder_portable_base,
     .type = MX25519_TYPE_PORTABLE
 };
 
 static const mx25519_impl impl_arm64 = {
 #if defined(PLATFORM_ARM64)
     .scmul = &mx25519_scalarmult_arm64,
+    /* X1 is multiplied in a NEON lane next to other products, so the
+       ladder has no cheaper base point variant */
+    .scmul_base = &mx25519_scalarmult_arm64,
+    .ladder = &mx25519_ladder_arm64,
+    .ladder_base = &mx25519_ladder_arm64,
 #else
     .scmul = NULL,
+    .scmul_base = NULL,
+    .ladder = NULL,
+    .ladder_base = NULL,
 #endif
     .type = MX25519_TYPE_ARM64
 };
@@ -33,8 +53,14 @@ static const mx25519_impl impl_arm64 = {
 static const mx25519_impl impl_amd64 = {
 #ifdef PLATFORM_AMD64
     .scmul = &mx25519_scalarmult_amd64,
+    .scmul_base = &mx25519_scalarmult_amd64_base,
+    .ladder = &mx25519_ladder_amd64,
+    .ladder_base = &mx25519_ladder_amd64_base,
 #else
     .scmul = NULL,
+    .scmul_base = NULL,
+    .ladder = NULL,
+    .ladder_base = NULL,
 #endif
     .type = MX25519_TYPE_AMD64
 };
@@ -42,15 +68,103 @@ static const mx25519_impl impl_amd64 = {
 static const mx25519_impl impl_amd64x = {
 #ifdef PLATFORM_AMD64
     .scmul = &mx25519_scalarmult_amd64x,
+    .scmul_base = &mx25519_scalarmult_amd64x_base,
+    .ladder = &mx25519_ladder_amd64x,
+    .ladder_base = &mx25519_ladder_amd64x_base,
 #else
     .scmul = NULL,
+    .scmul_base = NULL,
+    .ladder = NULL,
+    .ladder_base = NULL,
 #endif
     .type = MX25519_TYPE_AMD64X
 };
 
-const mx25519_impl* mx25519_impls[4] = {
+static const mx25519_impl impl_arm64_mul64 = {
+#if defined(PLATFORM_ARM64) && defined(PLATFORM_UINT128)
+    .scmul = &mx25519_scalarmult_arm64_mul64,
+    .scmul_base = &mx25519_scalarmult_arm64_mul64_base,
+    .ladder = &mx25519_ladder_arm64_mul64,
+    .ladder_base = &mx25519_ladder_arm64_mul64_base,
+#else
+    .scmul = NULL,
+    .scmul_base = NULL,
+    .ladder = NULL,
+    .ladder_base = NULL,
+#endif
+    .type = MX25519_TYPE_ARM64_MUL64
+};
+
+static const mx25519_impl impl_amd64_mulx = {
+#ifdef PLATFORM_AMD64
+    .scmul = &mx25519_scalarmult_amd64_mulx,
+    .scmul_base = &mx25519_scalarmult_amd64_mulx_base,
+    .ladder = &mx25519_ladder_amd64_mulx,
+    .ladder_base = &mx25519_ladder_amd64_mulx_base,
+#else
+    .scmul = NULL,
+    .scmul_base = NULL,
+    .ladder = NULL,
+    .ladder_base = NULL,
+#endif
+    .type = MX25519_TYPE_AMD64_MULX
+};
+
+static const mx25519_impl impl_amd64x_compact = {
+#ifdef PLATFORM_AMD64
+    .scmul = &mx25519_scalarmult_amd64x_compact,
+    .scmul_base = &mx25519_scalarmult_amd64x_compact_base,
+    .ladder = &mx25519_ladder_amd64x_compact,
+    .ladder_base = &mx25519_ladder_amd64x_compact_base,
+#else
+    .scmul = NULL,
+    .scmul_base = NULL,
+    .ladder = NULL,
+    .ladder_base = NULL,
+#endif
+    .type = MX25519_TYPE_AMD64X_COMPACT
+};
+
+static const mx25519_impl impl_arm64_sve2 = {
+#if defined(PLATFORM_ARM64) && defined(MX25519_SVE2)
+    .scmul = &mx25519_scalarmult_arm64_sve2,
+    .scmul_base = &mx25519_scalarmult_arm64_sve2_base,
+    .ladder = &mx25519_ladder_arm64_sve2,
+    .ladder_base = &mx25519_ladder_arm64_sve2_base,
+    .ladder_batch = &mx25519_ladder_batch_arm64_sve2,
+#else
+    .scmul = NULL,
+    .scmul_base = NULL,
+    .ladder = NULL,
+    .ladder_base = NULL,
+#endif
+    .type = MX25519_TYPE_ARM64_SVE2
+};
+
+const mx25519_impl mx25519_impl_amd64x_gpr = {
+#ifdef PLATFORM_AMD64
+    .scmul = &mx25519_scalarmult_amd64x_gpr,
+    .scmul_base = &mx25519_scalarmult_amd64x_gpr_base,
+    .ladder = &mx25519_ladder_amd64x,
+    .ladder_base = &mx25519_ladder_amd64x_base,
+#else
+    .scmul = NULL,
+    .scmul_base = NULL,
+    .ladder = NULL,
+    .ladder_base = NULL,
+#endif
+    .type = MX25519_TYPE_AMD64X
+};
+
+const mx25519_impl* mx25519_impls[MX25519_TYPE_COUNT] = {
     &impl_portable,
     &impl_arm64,
     &impl_amd64,
     &impl_amd64x,
+    &impl_arm64_mul64,
+    &impl_amd64_mulx,
+    &impl_amd64x_compact,
+    &impl_arm64_sve2,
 };
+
+#endif
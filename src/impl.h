@@ -9,6 +9,7 @@
 
 #include <mx25519.h>
 
+#include <stddef.h>
 #include <stdint.h>
 
 typedef void scmul_func(uint8_t result[32],
@@ -17,11 +18,129 @@ typedef void scmul_func(uint8_t result[32],
     uint8_t clamp_lo,
     uint8_t clamp_hi);
 
+/*
+ * scmul_func specialized for the base point u = 9. Each ladder step
+ * multiplies by the small constant 9 instead of X1. base must point to the
+ * encoding of 9, but the kernel doesn't have to read it.
+ */
+typedef scmul_func scmul_base_func;
+
+/*
+ * Like scmul_func, but outputs the projective Montgomery ladder result
+ * (X2:Z2) = key*P and (X3:Z3) = (key+1)*P as 4 consecutive little-endian
+ * 256-bit integers X2, Z2, X3, Z3 (not necessarily reduced mod 2^255-19).
+ */
+typedef void ladder_func(uint8_t result[128],
+    const uint8_t key[32],
+    const uint8_t base[32],
+    uint8_t clamp_lo,
+    uint8_t clamp_hi);
+
+/*
+ * ladder_func specialized for the base point u = 9, like scmul_base_func.
+ */
+typedef ladder_func ladder_base_func;
+
+/*
+ * Runs count independent ladders like ladder_func. keys and points are
+ * packed arrays of count 32-byte encodings, result receives count 128-byte
+ * records. Implementations that can run several ladders side by side
+ * provide this function, the others run one ladder_func call per key.
+ */
+typedef void ladder_batch_func(uint8_t* result,
+    const uint8_t* keys,
+    const uint8_t* points,
+    size_t count,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi);
+
+/*
+ * When the library is built with MX25519_FORCE_IMPL_<TYPE>, only one
+ * implementation is compiled in and its functions are called directly
+ * instead of through the dispatch table. See also mx25519_impl_forced.
+ */
+#if defined(MX25519_FORCE_IMPL_PORTABLE)
+#include "portable/scalarmult.h"
+#define IMPL_SCMUL(impl) mx25519_scalarmult_portable
+#define IMPL_SCMUL_BASE(impl) mx25519_scalarmult_portable_base
+#define IMPL_LADDER(impl) mx25519_ladder_portable
+#define IMPL_LADDER_BASE(impl) mx25519_ladder_portable_base
+#elif defined(MX25519_FORCE_IMPL_ARM64)
+#include "arm64/scalarmult.h"
+#define IMPL_SCMUL(impl) mx25519_scalarmult_arm64
+#define IMPL_SCMUL_BASE(impl) mx25519_scalarmult_arm64
+#define IMPL_LADDER(impl) mx25519_ladder_arm64
+#define IMPL_LADDER_BASE(impl) mx25519_ladder_arm64
+#elif defined(MX25519_FORCE_IMPL_AMD64)
+#include "amd64/scalarmult.h"
+#define IMPL_SCMUL(impl) mx25519_scalarmult_amd64
+#define IMPL_SCMUL_BASE(impl) mx25519_scalarmult_amd64_base
+#define IMPL_LADDER(impl) mx25519_ladder_amd64
+#define IMPL_LADDER_BASE(impl) mx25519_ladder_amd64_base
+#elif defined(MX25519_FORCE_IMPL_AMD64X) && defined(MX25519_AVOID_AVX)
+#include "amd64/scalarmult.h"
+#define IMPL_SCMUL(impl) mx25519_scalarmult_amd64x_gpr
+#define IMPL_SCMUL_BASE(impl) mx25519_scalarmult_amd64x_gpr_base
+#define IMPL_LADDER(impl) mx25519_ladder_amd64x
+#define IMPL_LADDER_BASE(impl) mx25519_ladder_amd64x_base
+#elif defined(MX25519_FORCE_IMPL_AMD64X)
+#include "amd64/scalarmult.h"
+#define IMPL_SCMUL(impl) mx25519_scalarmult_amd64x
+#define IMPL_SCMUL_BASE(impl) mx25519_scalarmult_amd64x_base
+#define IMPL_LADDER(impl) mx25519_ladder_amd64x
+#define IMPL_LADDER_BASE(impl) mx25519_ladder_amd64x_base
+#elif defined(MX25519_FORCE_IMPL_ARM64_MUL64)
+#include "arm64/scalarmult.h"
+#define IMPL_SCMUL(impl) mx25519_scalarmult_arm64_mul64
+#define IMPL_SCMUL_BASE(impl) mx25519_scalarmult_arm64_mul64_base
+#define IMPL_LADDER(impl) mx25519_ladder_arm64_mul64
+#define IMPL_LADDER_BASE(impl) mx25519_ladder_arm64_mul64_base
+#elif defined(MX25519_FORCE_IMPL_AMD64_MULX)
+#include "amd64/scalarmult.h"
+#define IMPL_SCMUL(impl) mx25519_scalarmult_amd64_mulx
+#define IMPL_SCMUL_BASE(impl) mx25519_scalarmult_amd64_mulx_base
+#define IMPL_LADDER(impl) mx25519_ladder_amd64_mulx
+#define IMPL_LADDER_BASE(impl) mx25519_ladder_amd64_mulx_base
+#elif defined(MX25519_FORCE_IMPL_AMD64X_COMPACT)
+#include "amd64/scalarmult.h"
+#define IMPL_SCMUL(impl) mx25519_scalarmult_amd64x_compact
+#define IMPL_SCMUL_BASE(impl) mx25519_scalarmult_amd64x_compact_base
+#define IMPL_LADDER(impl) mx25519_ladder_amd64x_compact
+#define IMPL_LADDER_BASE(impl) mx25519_ladder_amd64x_compact_base
+#elif defined(MX25519_FORCE_IMPL_ARM64_SVE2)
+#include "arm64/scalarmult.h"
+#define IMPL_SCMUL(impl) mx25519_scalarmult_arm64_sve2
+#define IMPL_SCMUL_BASE(impl) mx25519_scalarmult_arm64_sve2_base
+#define IMPL_LADDER(impl) mx25519_ladder_arm64_sve2
+#define IMPL_LADDER_BASE(impl) mx25519_ladder_arm64_sve2_base
+#define IMPL_LADDER_BATCH(impl) mx25519_ladder_batch_arm64_sve2
+#else
+#define IMPL_SCMUL(impl) ((impl)->scmul)
+#define IMPL_SCMUL_BASE(impl) ((impl)->scmul_base)
+#define IMPL_LADDER(impl) ((impl)->ladder)
+#define IMPL_LADDER_BASE(impl) ((impl)->ladder_base)
+#define IMPL_LADDER_BATCH(impl) ((impl)->ladder_batch)
+#endif
+
+#ifndef IMPL_LADDER_BATCH
+#define IMPL_LADDER_BATCH(impl) ((ladder_batch_func*)NULL)
+#endif
+
 typedef struct mx25519_impl {
+#ifndef MX25519_FORCE_IMPL
     scmul_func* scmul;
+    scmul_base_func* scmul_base;
+    ladder_func* ladder;
+    ladder_base_func* ladder_base;
+    ladder_batch_func* ladder_batch; /* optional, may be NULL */
+#endif
     mx25519_type type;
 } mx25519_impl;
 
-extern const mx25519_impl* mx25519_impls[4];
+#ifndef MX25519_FORCE_IMPL
+extern const mx25519_impl* mx25519_impls[MX25519_TYPE_COUNT];
+/* AMD64X variant without AVX2, selected if AVX2 is missing or avoided */
+extern const mx25519_impl mx25519_impl_amd64x_gpr;
+#endif
 
 #endif
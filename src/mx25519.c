@@ -9,16 +9,33 @@
 #include "impl.h"
 #include "cpu.h"
 #include "platform.h"
+#include "portable/point.h"
+#include "stats.h"
+#include "trace.h"
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include <assert.h>
 
+/* number of projective ladder results buffered by mx25519_scmul_key_batch */
+#define BATCH_CHUNK 32
+
 static const mx25519_pubkey x25519_base = {
     .data = { 9 }
 };
 
+static const mx25519_point x25519_base_full = {
+    .u = { 9 },
+    .v = {
+        217, 211, 206, 126, 162, 197, 233, 41, 178, 97, 124, 109, 126, 77, 61, 146,
+        76, 209, 72, 119, 44, 221, 30, 224, 180, 134, 160, 184, 161, 25, 174, 32 }
+};
+
 static bool impl_supported(mx25519_type impl) {
+#ifdef MX25519_FORCE_IMPL
+    return impl == MX25519_FORCE_IMPL;
+#else
     if (impl == MX25519_TYPE_PORTABLE) {
         return true;
     }
@@ -38,48 +55,165 @@ static bool impl_supported(mx25519_type impl) {
     }
     if (impl == MX25519_TYPE_AMD64X) {
 #if defined(PLATFORM_AMD64)
+        /* AVX2 is optional, see amd64x_variant */
+        x25519_cpu_cap cap = mx25519_get_cpu_cap();
+        return (cap & X25519_CPU_CAP_MULX) != 0
+            && (cap & X25519_CPU_CAP_ADX)  != 0;
+#else
+        return false;
+#endif
+    }
+    if (impl == MX25519_TYPE_AMD64_MULX) {
+#if defined(PLATFORM_AMD64)
+        /* MULX is part of BMI2, the inversion uses AVX2 */
         x25519_cpu_cap cap = mx25519_get_cpu_cap();
         return (cap & X25519_CPU_CAP_MULX) != 0
-            && (cap & X25519_CPU_CAP_ADX)  != 0
             && (cap & X25519_CPU_CAP_AVX2) != 0;
 #else
         return false;
+#endif
+    }
+    if (impl == MX25519_TYPE_AMD64X_COMPACT) {
+#if defined(PLATFORM_AMD64)
+        x25519_cpu_cap cap = mx25519_get_cpu_cap();
+        return (cap & X25519_CPU_CAP_MULX) != 0
+            && (cap & X25519_CPU_CAP_ADX)  != 0;
+#else
+        return false;
+#endif
+    }
+    if (impl == MX25519_TYPE_ARM64_MUL64) {
+#if defined(PLATFORM_ARM64) && defined(PLATFORM_UINT128)
+        return true;
+#else
+        return false;
+#endif
+    }
+    if (impl == MX25519_TYPE_ARM64_SVE2) {
+#if defined(PLATFORM_ARM64) && defined(MX25519_SVE2)
+        return (mx25519_get_cpu_cap() & X25519_CPU_CAP_SVE2) != 0;
+#else
+        return false;
 #endif
     }
     return false;
+#endif
 }
 
 static mx25519_type select_best_impl(void) {
-#if defined(PLATFORM_AMD64)
+#if defined(MX25519_FORCE_IMPL)
+    return MX25519_FORCE_IMPL;
+#elif defined(PLATFORM_AMD64)
     if (impl_supported(MX25519_TYPE_AMD64X)) {
         return MX25519_TYPE_AMD64X;
     }
+    /* Haswell and AMD Excavator have MULX, but not ADX */
+    if (impl_supported(MX25519_TYPE_AMD64_MULX)) {
+        return MX25519_TYPE_AMD64_MULX;
+    }
     return MX25519_TYPE_AMD64;
 #elif defined(PLATFORM_ARM64)
+    /* the NEON ladder is faster on in-order and narrow cores */
+    if (impl_supported(MX25519_TYPE_ARM64_MUL64)
+        && (mx25519_get_cpu_cap() & X25519_CPU_CAP_WIDE_MUL) != 0) {
+        return MX25519_TYPE_ARM64_MUL64;
+    }
     return MX25519_TYPE_ARM64;
 #else
     return MX25519_TYPE_PORTABLE;
 #endif
 }
 
+static uint8_t clamp_lsb_mask(mx25519_unclamp_flags unclamp_flags) {
+    return 248 | ((unclamp_flags & MX25519_UNCLAMP_LSBS) * 7);
+}
+
+static uint8_t clamp_msb_mask(mx25519_unclamp_flags unclamp_flags) {
+    return (~unclamp_flags & MX25519_UNCLAMP_254) << 5;
+}
+
+static void scalar_wipe(void* ptr, size_t size) {
+    volatile uint8_t* p = ptr;
+    while (size--) {
+        *p++ = 0;
+    }
+}
+
 static void clamp_and_dispatch(const mx25519_impl* impl,
     mx25519_pubkey* result, const mx25519_privkey* key,
-    const mx25519_pubkey* pt, mx25519_unclamp_flags unclamp_flags)
+    const mx25519_pubkey* pt, mx25519_unclamp_flags unclamp_flags,
+    mx25519_op op)
 {
-    const uint8_t lsb_mask = 248 | ((unclamp_flags & MX25519_UNCLAMP_LSBS) * 7);
-    const uint8_t msb_mask = (~unclamp_flags & MX25519_UNCLAMP_254) << 5;
+    const uint8_t lsb_mask = clamp_lsb_mask(unclamp_flags);
+    const uint8_t msb_mask = clamp_msb_mask(unclamp_flags);
+    uint64_t start;
 
     assert(impl != NULL);
     assert(pt != NULL);
     assert(key != NULL);
     assert(result != NULL);
+#ifndef MX25519_FORCE_IMPL
     assert(impl->scmul != NULL);
-    assert(impl->type <= MX25519_TYPE_AMD64X);
+    assert(impl->scmul_base != NULL);
+#endif
+    assert(impl->type >= 0 && impl->type < MX25519_TYPE_COUNT);
 
     /* dispatch */
-    impl->scmul(result->data, key->data, pt->data, lsb_mask, msb_mask);
+    TRACE_PROBE2(scmul__entry, impl->type, op);
+    start = stats_begin();
+    if (pt == &x25519_base) {
+        IMPL_SCMUL_BASE(impl)(result->data, key->data, pt->data, lsb_mask,
+            msb_mask);
+    }
+    else {
+        IMPL_SCMUL(impl)(result->data, key->data, pt->data, lsb_mask,
+            msb_mask);
+    }
+    stats_end(start, impl->type, op, 1);
+    TRACE_PROBE2(scmul__exit, impl->type, op);
+}
+
+static void ladder_and_recover(const mx25519_impl* impl,
+    mx25519_point* result, const mx25519_privkey* key,
+    const mx25519_point* pt, mx25519_op op)
+{
+    uint8_t xz[128];
+    uint64_t start;
+
+    assert(impl != NULL);
+    assert(pt != NULL);
+    assert(key != NULL);
+    assert(result != NULL);
+#ifndef MX25519_FORCE_IMPL
+    assert(impl->ladder != NULL);
+#endif
+
+    TRACE_PROBE2(scmul__entry, impl->type, op);
+    start = stats_begin();
+    IMPL_LADDER(impl)(xz, key->data, pt->u,
+        clamp_lsb_mask(MX25519_UNCLAMP_NONE),
+        clamp_msb_mask(MX25519_UNCLAMP_NONE));
+    mx25519_point_recover(result->u, result->v, xz, pt->u, pt->v);
+    stats_end(start, impl->type, op, 1);
+    TRACE_PROBE2(scmul__exit, impl->type, op);
 }
 
+#ifndef MX25519_FORCE_IMPL
+/*
+ * Picks whether the AMD64X final inversion uses AVX2. Without AVX2, or when
+ * built with MX25519_AVOID_AVX, the kernel doesn't touch any vector
+ * registers.
+ */
+static const mx25519_impl* amd64x_variant(void) {
+#ifndef MX25519_AVOID_AVX
+    if ((mx25519_get_cpu_cap() & X25519_CPU_CAP_AVX2) != 0) {
+        return mx25519_impls[MX25519_TYPE_AMD64X];
+    }
+#endif
+    return &mx25519_impl_amd64x_gpr;
+}
+#endif
+
 const mx25519_impl* mx25519_select_impl(mx25519_type type)
 {
     if (type == MX25519_TYPE_AUTO) {
@@ -88,8 +222,15 @@ const mx25519_impl* mx25519_select_impl(mx25519_type type)
     else if (!impl_supported(type)) {
         return NULL;
     }
-    assert(type >= 0 && type < 4);
+#ifdef MX25519_FORCE_IMPL
+    return &mx25519_impl_forced;
+#else
+    assert(type >= 0 && type < MX25519_TYPE_COUNT);
+    if (type == MX25519_TYPE_AMD64X) {
+        return amd64x_variant();
+    }
     return mx25519_impls[type];
+#endif
 }
 
 mx25519_type mx25519_impl_type(const mx25519_impl* impl)
@@ -101,25 +242,160 @@ mx25519_type mx25519_impl_type(const mx25519_impl* impl)
 void mx25519_scmul_base(const mx25519_impl* impl, mx25519_pubkey* result,
     const mx25519_privkey* key)
 {
-    clamp_and_dispatch(impl, result, key, &x25519_base, MX25519_UNCLAMP_NONE);
+    clamp_and_dispatch(impl, result, key, &x25519_base, MX25519_UNCLAMP_NONE,
+        MX25519_OP_BASE);
 }
 
 void mx25519_scmul_base_unclamped(const mx25519_impl* impl,
     mx25519_pubkey* result, const mx25519_privkey* key,
     mx25519_unclamp_flags unclamp_flags)
 {
-    clamp_and_dispatch(impl, result, key, &x25519_base, unclamp_flags);
+    clamp_and_dispatch(impl, result, key, &x25519_base, unclamp_flags,
+        MX25519_OP_BASE_UNCLAMPED);
 }
 
 void mx25519_scmul_key(const mx25519_impl* impl, mx25519_pubkey* result,
     const mx25519_privkey* key, const mx25519_pubkey* pt)
 {
-    clamp_and_dispatch(impl, result, key, pt, MX25519_UNCLAMP_NONE);
+    clamp_and_dispatch(impl, result, key, pt, MX25519_UNCLAMP_NONE,
+        MX25519_OP_KEY);
 }
 
 void mx25519_scmul_key_unclamped(const mx25519_impl* impl,
     mx25519_pubkey* result, const mx25519_privkey* key,
     const mx25519_pubkey* pt, mx25519_unclamp_flags unclamp_flags)
 {
-    clamp_and_dispatch(impl, result, key, pt, unclamp_flags);
+    clamp_and_dispatch(impl, result, key, pt, unclamp_flags,
+        MX25519_OP_KEY_UNCLAMPED);
+}
+
+void mx25519_scmul_base_full(const mx25519_impl* impl, mx25519_point* result,
+    const mx25519_privkey* key)
+{
+    ladder_and_recover(impl, result, key, &x25519_base_full,
+        MX25519_OP_BASE_FULL);
+}
+
+void mx25519_scmul_key_full(const mx25519_impl* impl, mx25519_point* result,
+    const mx25519_privkey* key, const mx25519_point* pt)
+{
+    ladder_and_recover(impl, result, key, pt, MX25519_OP_KEY_FULL);
+}
+
+void mx25519_scmul_base_and_key(const mx25519_impl* impl,
+    mx25519_pubkey* pub, mx25519_pubkey* shared, const mx25519_privkey* key,
+    const mx25519_pubkey* pt)
+{
+    uint8_t xz[2][128];
+    uint8_t out[2][32];
+    uint8_t e[32];
+    uint64_t start;
+
+    assert(impl != NULL);
+    assert(pub != NULL);
+    assert(shared != NULL);
+    assert(key != NULL);
+    assert(pt != NULL);
+#ifndef MX25519_FORCE_IMPL
+    assert(impl->ladder != NULL);
+    assert(impl->ladder_base != NULL);
+#endif
+
+    TRACE_PROBE2(scmul__entry, impl->type, MX25519_OP_BASE_AND_KEY);
+    start = stats_begin();
+    /* clamp once, the kernels are then told to leave the scalar as is */
+    memcpy(e, key->data, sizeof(e));
+    e[0] &= clamp_lsb_mask(MX25519_UNCLAMP_NONE);
+    e[31] = (e[31] & 127) | clamp_msb_mask(MX25519_UNCLAMP_NONE);
+    IMPL_LADDER_BASE(impl)(xz[0], e, x25519_base.data, 255, 0);
+    IMPL_LADDER(impl)(xz[1], e, pt->data, 255, 0);
+    scalar_wipe(e, sizeof(e));
+    mx25519_point_normalize(out[0], xz[0], sizeof(xz[0]), 2);
+    stats_end(start, impl->type, MX25519_OP_BASE_AND_KEY, 2);
+    TRACE_PROBE2(scmul__exit, impl->type, MX25519_OP_BASE_AND_KEY);
+    memcpy(pub->data, out[0], sizeof(pub->data));
+    memcpy(shared->data, out[1], sizeof(shared->data));
+}
+
+void mx25519_scmul_key_batch(const mx25519_impl* impl,
+    mx25519_pubkey* results, const mx25519_privkey* keys,
+    const mx25519_pubkey* points, size_t count)
+{
+    uint8_t xz[BATCH_CHUNK][128];
+    const uint8_t lsb_mask = clamp_lsb_mask(MX25519_UNCLAMP_NONE);
+    const uint8_t msb_mask = clamp_msb_mask(MX25519_UNCLAMP_NONE);
+    const size_t total = count;
+    ladder_batch_func* ladder_batch = IMPL_LADDER_BATCH(impl);
+    size_t i, n;
+    uint64_t start;
+
+    assert(impl != NULL);
+#ifndef MX25519_FORCE_IMPL
+    assert(impl->ladder != NULL);
+#endif
+    assert(count == 0 || (results != NULL && keys != NULL && points != NULL));
+
+    TRACE_PROBE2(batch__entry, impl->type, count);
+    while (count > 0) {
+        n = count < BATCH_CHUNK ? count : BATCH_CHUNK;
+        start = stats_begin();
+        if (ladder_batch != NULL) {
+            ladder_batch(xz[0], keys->data, points->data, n,
+                lsb_mask, msb_mask);
+        }
+        else {
+            for (i = 0; i < n; ++i) {
+                IMPL_LADDER(impl)(xz[i], keys[i].data, points[i].data,
+                    lsb_mask, msb_mask);
+            }
+        }
+        TRACE_PROBE2(ladder__exit, impl->type, n);
+        mx25519_point_normalize(results->data, xz[0], sizeof(xz[0]), n);
+        stats_end(start, impl->type, MX25519_OP_KEY_BATCH, n);
+        results += n;
+        keys += n;
+        points += n;
+        count -= n;
+    }
+    TRACE_PROBE2(batch__exit, impl->type, total);
+}
+
+void mx25519_scmul_key_projective(const mx25519_impl* impl,
+    mx25519_projective* result, const mx25519_privkey* key,
+    const mx25519_pubkey* pt)
+{
+    uint8_t xz[128];
+    uint64_t start;
+
+    assert(impl != NULL);
+    assert(pt != NULL);
+    assert(key != NULL);
+    assert(result != NULL);
+
+    TRACE_PROBE2(scmul__entry, impl->type, MX25519_OP_KEY_PROJECTIVE);
+    start = stats_begin();
+    IMPL_LADDER(impl)(xz, key->data, pt->data,
+        clamp_lsb_mask(MX25519_UNCLAMP_NONE),
+        clamp_msb_mask(MX25519_UNCLAMP_NONE));
+    stats_end(start, impl->type, MX25519_OP_KEY_PROJECTIVE, 1);
+    TRACE_PROBE2(scmul__exit, impl->type, MX25519_OP_KEY_PROJECTIVE);
+    memcpy(result->data, xz, sizeof(result->data));
+}
+
+int mx25519_projective_equals(const mx25519_pubkey* u,
+    const mx25519_projective* xz)
+{
+    assert(u != NULL);
+    assert(xz != NULL);
+    return mx25519_point_equals(u->data, xz->data);
+}
+
+void mx25519_projective_normalize_batch(mx25519_pubkey* results,
+    const mx25519_projective* points, size_t count)
+{
+    assert(count == 0 || (results != NULL && points != NULL));
+    if (count > 0) {
+        mx25519_point_normalize(results->data, points->data,
+            sizeof(mx25519_projective), count);
+    }
 }
@@ -37,6 +37,7 @@
 
 #if defined(__SIZEOF_INT128__)
 typedef unsigned __int128 uint128_t;
+typedef __int128 int128_t;
 #define PLATFORM_UINT128 /* compiler support for 128-bit integers */
 #endif
 
@@ -49,6 +50,13 @@ typedef unsigned __int128 uint128_t;
 #define FORCE_INLINE INLINE
 #endif
 
+/* static helpers from shared headers that some includers don't call */
+#if defined(__GNUC__) || defined(__clang__)
+#define MAYBE_UNUSED __attribute__((unused))
+#else
+#define MAYBE_UNUSED
+#endif
+
 /* detect native little-endian platforms */
 #if (defined(__BYTE_ORDER__) &&                                                \
      (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)) ||                           \
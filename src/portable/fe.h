@@ -11,6 +11,8 @@
 #pragma warning(disable: 4146) /* unary minus applied to unsigned type */
 #endif
 
+#include "../platform.h"
+
 #include <stdint.h>
 
 typedef int32_t fe[10];
@@ -23,20 +25,24 @@ t[0]+2^26 t[1]+2^51 t[2]+2^77 t[3]+2^102 t[4]+...+2^230 t[9].
 Bounds on each t[i] vary depending on context.
 */
 
-static void fe_frombytes(fe,const uint8_t *);
-static void fe_tobytes(uint8_t *,fe);
-
-static void fe_copy(fe,fe);
-static void fe_0(fe);
-static void fe_1(fe);
-static void fe_cswap(fe,fe,unsigned int);
-
-static void fe_add(fe,fe,fe);
-static void fe_sub(fe,fe,fe);
-static void fe_mul(fe,fe,fe);
-static void fe_sq(fe,fe);
-static void fe_mul121666(fe,fe);
-static void fe_invert(fe,fe);
+static MAYBE_UNUSED void fe_frombytes(fe,const uint8_t *);
+static MAYBE_UNUSED void fe_tobytes(uint8_t *,fe);
+
+static MAYBE_UNUSED void fe_copy(fe,fe);
+static MAYBE_UNUSED void fe_0(fe);
+static MAYBE_UNUSED void fe_1(fe);
+static MAYBE_UNUSED void fe_cswap(fe,fe,unsigned int);
+static MAYBE_UNUSED void fe_cswap2(fe,fe,fe,fe,unsigned int);
+
+static MAYBE_UNUSED void fe_add(fe,fe,fe);
+static MAYBE_UNUSED void fe_sub(fe,fe,fe);
+static MAYBE_UNUSED void fe_addsub(fe,fe,fe,fe);
+static MAYBE_UNUSED void fe_mul(fe,fe,fe);
+static MAYBE_UNUSED void fe_sq(fe,fe);
+static MAYBE_UNUSED void fe_mul_small(fe,fe,int32_t);
+static MAYBE_UNUSED void fe_mul121666(fe,fe);
+static MAYBE_UNUSED void fe_mul121666_add(fe,fe,fe);
+static MAYBE_UNUSED void fe_invert(fe,fe);
 
 static uint64_t load_3(const uint8_t *in)
 {
@@ -857,17 +863,181 @@ static void fe_sq(fe h, fe f)
 }
 
 /*
-h = f * 121666
+h = f * c
 Can overlap h with f.
 
 Preconditions:
+   0 < c <= 121666
    |f| bounded by 1.1*2^26,1.1*2^25,1.1*2^26,1.1*2^25,etc.
 
 Postconditions:
    |h| bounded by 1.1*2^25,1.1*2^24,1.1*2^25,1.1*2^24,etc.
 */
 
+static void fe_mul_small(fe h, fe f, int32_t c)
+{
+    int32_t f0 = f[0];
+    int32_t f1 = f[1];
+    int32_t f2 = f[2];
+    int32_t f3 = f[3];
+    int32_t f4 = f[4];
+    int32_t f5 = f[5];
+    int32_t f6 = f[6];
+    int32_t f7 = f[7];
+    int32_t f8 = f[8];
+    int32_t f9 = f[9];
+    int64_t h0 = f0 * (int64_t)c;
+    int64_t h1 = f1 * (int64_t)c;
+    int64_t h2 = f2 * (int64_t)c;
+    int64_t h3 = f3 * (int64_t)c;
+    int64_t h4 = f4 * (int64_t)c;
+    int64_t h5 = f5 * (int64_t)c;
+    int64_t h6 = f6 * (int64_t)c;
+    int64_t h7 = f7 * (int64_t)c;
+    int64_t h8 = f8 * (int64_t)c;
+    int64_t h9 = f9 * (int64_t)c;
+    int64_t carry0;
+    int64_t carry1;
+    int64_t carry2;
+    int64_t carry3;
+    int64_t carry4;
+    int64_t carry5;
+    int64_t carry6;
+    int64_t carry7;
+    int64_t carry8;
+    int64_t carry9;
+
+    carry9 = (h9 + (int64_t)(1 << 24)) >> 25; h0 += carry9 * 19; h9 -= carry9 << 25;
+    carry1 = (h1 + (int64_t)(1 << 24)) >> 25; h2 += carry1; h1 -= carry1 << 25;
+    carry3 = (h3 + (int64_t)(1 << 24)) >> 25; h4 += carry3; h3 -= carry3 << 25;
+    carry5 = (h5 + (int64_t)(1 << 24)) >> 25; h6 += carry5; h5 -= carry5 << 25;
+    carry7 = (h7 + (int64_t)(1 << 24)) >> 25; h8 += carry7; h7 -= carry7 << 25;
+
+    carry0 = (h0 + (int64_t)(1 << 25)) >> 26; h1 += carry0; h0 -= carry0 << 26;
+    carry2 = (h2 + (int64_t)(1 << 25)) >> 26; h3 += carry2; h2 -= carry2 << 26;
+    carry4 = (h4 + (int64_t)(1 << 25)) >> 26; h5 += carry4; h4 -= carry4 << 26;
+    carry6 = (h6 + (int64_t)(1 << 25)) >> 26; h7 += carry6; h6 -= carry6 << 26;
+    carry8 = (h8 + (int64_t)(1 << 25)) >> 26; h9 += carry8; h8 -= carry8 << 26;
+
+    h[0] = h0;
+    h[1] = h1;
+    h[2] = h2;
+    h[3] = h3;
+    h[4] = h4;
+    h[5] = h5;
+    h[6] = h6;
+    h[7] = h7;
+    h[8] = h8;
+    h[9] = h9;
+}
+
+/*
+h = f * 121666
+*/
+
 static void fe_mul121666(fe h, fe f)
+{
+    fe_mul_small(h, f, 121666);
+}
+
+/*
+Replace (f,g,u,v) with (g,f,v,u) if b == 1;
+replace (f,g,u,v) with (f,g,u,v) if b == 0.
+Same as fe_cswap(f,g,b); fe_cswap(u,v,b) with one mask.
+
+Preconditions: b in {0,1}.
+*/
+
+static void fe_cswap2(fe f, fe g, fe u, fe v, unsigned int b)
+{
+    int32_t mask = -(int32_t)b;
+    int32_t x0;
+    int32_t x1;
+    int32_t x2;
+    int32_t x3;
+    int32_t x4;
+    int32_t x5;
+    int32_t x6;
+    int32_t x7;
+    int32_t x8;
+    int32_t x9;
+    x0 = (f[0] ^ g[0]) & mask;
+    x1 = (f[1] ^ g[1]) & mask;
+    x2 = (f[2] ^ g[2]) & mask;
+    x3 = (f[3] ^ g[3]) & mask;
+    x4 = (f[4] ^ g[4]) & mask;
+    x5 = (f[5] ^ g[5]) & mask;
+    x6 = (f[6] ^ g[6]) & mask;
+    x7 = (f[7] ^ g[7]) & mask;
+    x8 = (f[8] ^ g[8]) & mask;
+    x9 = (f[9] ^ g[9]) & mask;
+    f[0] ^= x0;
+    f[1] ^= x1;
+    f[2] ^= x2;
+    f[3] ^= x3;
+    f[4] ^= x4;
+    f[5] ^= x5;
+    f[6] ^= x6;
+    f[7] ^= x7;
+    f[8] ^= x8;
+    f[9] ^= x9;
+    g[0] ^= x0;
+    g[1] ^= x1;
+    g[2] ^= x2;
+    g[3] ^= x3;
+    g[4] ^= x4;
+    g[5] ^= x5;
+    g[6] ^= x6;
+    g[7] ^= x7;
+    g[8] ^= x8;
+    g[9] ^= x9;
+    x0 = (u[0] ^ v[0]) & mask;
+    x1 = (u[1] ^ v[1]) & mask;
+    x2 = (u[2] ^ v[2]) & mask;
+    x3 = (u[3] ^ v[3]) & mask;
+    x4 = (u[4] ^ v[4]) & mask;
+    x5 = (u[5] ^ v[5]) & mask;
+    x6 = (u[6] ^ v[6]) & mask;
+    x7 = (u[7] ^ v[7]) & mask;
+    x8 = (u[8] ^ v[8]) & mask;
+    x9 = (u[9] ^ v[9]) & mask;
+    u[0] ^= x0;
+    u[1] ^= x1;
+    u[2] ^= x2;
+    u[3] ^= x3;
+    u[4] ^= x4;
+    u[5] ^= x5;
+    u[6] ^= x6;
+    u[7] ^= x7;
+    u[8] ^= x8;
+    u[9] ^= x9;
+    v[0] ^= x0;
+    v[1] ^= x1;
+    v[2] ^= x2;
+    v[3] ^= x3;
+    v[4] ^= x4;
+    v[5] ^= x5;
+    v[6] ^= x6;
+    v[7] ^= x7;
+    v[8] ^= x8;
+    v[9] ^= x9;
+}
+
+/*
+s = f + g
+d = f - g
+Can overlap s or d with f or g, but not s with d.
+
+Preconditions:
+   |f| bounded by 1.1*2^25,1.1*2^24,1.1*2^25,1.1*2^24,etc.
+   |g| bounded by 1.1*2^25,1.1*2^24,1.1*2^25,1.1*2^24,etc.
+
+Postconditions:
+   |s| bounded by 1.1*2^26,1.1*2^25,1.1*2^26,1.1*2^25,etc.
+   |d| bounded by 1.1*2^26,1.1*2^25,1.1*2^26,1.1*2^25,etc.
+*/
+
+static void fe_addsub(fe s, fe d, fe f, fe g)
 {
     int32_t f0 = f[0];
     int32_t f1 = f[1];
@@ -879,16 +1049,63 @@ static void fe_mul121666(fe h, fe f)
     int32_t f7 = f[7];
     int32_t f8 = f[8];
     int32_t f9 = f[9];
-    int64_t h0 = f0 * (int64_t)121666;
-    int64_t h1 = f1 * (int64_t)121666;
-    int64_t h2 = f2 * (int64_t)121666;
-    int64_t h3 = f3 * (int64_t)121666;
-    int64_t h4 = f4 * (int64_t)121666;
-    int64_t h5 = f5 * (int64_t)121666;
-    int64_t h6 = f6 * (int64_t)121666;
-    int64_t h7 = f7 * (int64_t)121666;
-    int64_t h8 = f8 * (int64_t)121666;
-    int64_t h9 = f9 * (int64_t)121666;
+    int32_t g0 = g[0];
+    int32_t g1 = g[1];
+    int32_t g2 = g[2];
+    int32_t g3 = g[3];
+    int32_t g4 = g[4];
+    int32_t g5 = g[5];
+    int32_t g6 = g[6];
+    int32_t g7 = g[7];
+    int32_t g8 = g[8];
+    int32_t g9 = g[9];
+    s[0] = f0 + g0;
+    s[1] = f1 + g1;
+    s[2] = f2 + g2;
+    s[3] = f3 + g3;
+    s[4] = f4 + g4;
+    s[5] = f5 + g5;
+    s[6] = f6 + g6;
+    s[7] = f7 + g7;
+    s[8] = f8 + g8;
+    s[9] = f9 + g9;
+    d[0] = f0 - g0;
+    d[1] = f1 - g1;
+    d[2] = f2 - g2;
+    d[3] = f3 - g3;
+    d[4] = f4 - g4;
+    d[5] = f5 - g5;
+    d[6] = f6 - g6;
+    d[7] = f7 - g7;
+    d[8] = f8 - g8;
+    d[9] = f9 - g9;
+}
+
+/*
+h = f * 121666 + g
+Can overlap h with f or g.
+Same as fe_mul121666(t,f); fe_add(h,g,t) with a single carry pass.
+
+Preconditions:
+   |f| bounded by 1.1*2^26,1.1*2^25,1.1*2^26,1.1*2^25,etc.
+   |g| bounded by 1.1*2^25,1.1*2^24,1.1*2^25,1.1*2^24,etc.
+
+Postconditions:
+   |h| bounded by 1.1*2^25,1.1*2^24,1.1*2^25,1.1*2^24,etc.
+*/
+
+static void fe_mul121666_add(fe h, fe f, fe g)
+{
+    int64_t h0 = f[0] * (int64_t)121666 + g[0];
+    int64_t h1 = f[1] * (int64_t)121666 + g[1];
+    int64_t h2 = f[2] * (int64_t)121666 + g[2];
+    int64_t h3 = f[3] * (int64_t)121666 + g[3];
+    int64_t h4 = f[4] * (int64_t)121666 + g[4];
+    int64_t h5 = f[5] * (int64_t)121666 + g[5];
+    int64_t h6 = f[6] * (int64_t)121666 + g[6];
+    int64_t h7 = f[7] * (int64_t)121666 + g[7];
+    int64_t h8 = f[8] * (int64_t)121666 + g[8];
+    int64_t h9 = f[9] * (int64_t)121666 + g[9];
     int64_t carry0;
     int64_t carry1;
     int64_t carry2;
@@ -900,17 +1117,24 @@ static void fe_mul121666(fe h, fe f)
     int64_t carry8;
     int64_t carry9;
 
+    /* |h0|,|h2|,... <= 1.1*2^26 * 121666 + 1.1*2^25 < 1.03*2^43 */
+    /* |h1|,|h3|,... < 1.03*2^42 */
+
     carry9 = (h9 + (int64_t)(1 << 24)) >> 25; h0 += carry9 * 19; h9 -= carry9 << 25;
     carry1 = (h1 + (int64_t)(1 << 24)) >> 25; h2 += carry1; h1 -= carry1 << 25;
     carry3 = (h3 + (int64_t)(1 << 24)) >> 25; h4 += carry3; h3 -= carry3 << 25;
     carry5 = (h5 + (int64_t)(1 << 24)) >> 25; h6 += carry5; h5 -= carry5 << 25;
     carry7 = (h7 + (int64_t)(1 << 24)) >> 25; h8 += carry7; h7 -= carry7 << 25;
+    /* |h1|,|h3|,...,|h9| <= 2^24 */
+    /* |carry9 * 19| < 2^21.3, |h0| < 1.04*2^43 */
 
     carry0 = (h0 + (int64_t)(1 << 25)) >> 26; h1 += carry0; h0 -= carry0 << 26;
     carry2 = (h2 + (int64_t)(1 << 25)) >> 26; h3 += carry2; h2 -= carry2 << 26;
     carry4 = (h4 + (int64_t)(1 << 25)) >> 26; h5 += carry4; h4 -= carry4 << 26;
     carry6 = (h6 + (int64_t)(1 << 25)) >> 26; h7 += carry6; h6 -= carry6 << 26;
     carry8 = (h8 + (int64_t)(1 << 25)) >> 26; h9 += carry8; h8 -= carry8 << 26;
+    /* |h0|,|h2|,...,|h8| <= 2^25 */
+    /* |h1|,|h3|,...,|h9| <= 2^24 + 2^17.1 < 1.01*2^24 */
 
     h[0] = h0;
     h[1] = h1;
@@ -0,0 +1,473 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+#ifndef FE64_H
+#define FE64_H
+
+#include "../platform.h"
+
+#include <stdint.h>
+
+#ifndef PLATFORM_UINT128
+#error "fe64.h requires compiler support for 128-bit integers"
+#endif
+
+/*
+ * Field element with 4 64-bit limbs. The represented value is
+ * t[0] + 2^64 t[1] + 2^128 t[2] + 2^192 t[3], which can be anywhere
+ * in the range [0, 2^256), i.e. the arithmetic is done modulo 2^256-38.
+ * Only fe64_tobytes produces the canonical representation.
+ *
+ * The 128-bit products compile to mul/umulh on ARM64 and to mul/mulx on AMD64.
+ */
+typedef uint64_t fe64[4];
+
+static FORCE_INLINE void fe64_frombytes(fe64 h, const uint8_t* s) {
+    h[0] = platform_load64(s);
+    h[1] = platform_load64(s + 8);
+    h[2] = platform_load64(s + 16);
+    h[3] = platform_load64(s + 24) & 0x7fffffffffffffff;
+}
+
+/* Fully reduces h modulo 2^255-19. */
+static FORCE_INLINE void fe64_reduce(fe64 h) {
+    uint128_t c;
+    uint64_t t, mask;
+
+    /* fold bit 255: h < 2^255 + 19 * 2 */
+    t = (h[3] >> 63) * 19;
+    h[3] &= 0x7fffffffffffffff;
+    c = (uint128_t)h[0] + t;
+    h[0] = (uint64_t)c;
+    c = (uint128_t)h[1] + (uint64_t)(c >> 64);
+    h[1] = (uint64_t)c;
+    c = (uint128_t)h[2] + (uint64_t)(c >> 64);
+    h[2] = (uint64_t)c;
+    h[3] += (uint64_t)(c >> 64);
+
+    /* h + 19 >= 2^255 iff h >= p, in which case h - p = (h + 19) mod 2^255 */
+    uint64_t r0, r1, r2, r3;
+    c = (uint128_t)h[0] + 19;
+    r0 = (uint64_t)c;
+    c = (uint128_t)h[1] + (uint64_t)(c >> 64);
+    r1 = (uint64_t)c;
+    c = (uint128_t)h[2] + (uint64_t)(c >> 64);
+    r2 = (uint64_t)c;
+    r3 = h[3] + (uint64_t)(c >> 64);
+    mask = 0 - (r3 >> 63);
+    r3 &= 0x7fffffffffffffff;
+    h[0] ^= (h[0] ^ r0) & mask;
+    h[1] ^= (h[1] ^ r1) & mask;
+    h[2] ^= (h[2] ^ r2) & mask;
+    h[3] ^= (h[3] ^ r3) & mask;
+}
+
+static FORCE_INLINE void fe64_tobytes(uint8_t* s, const fe64 f) {
+    fe64 h = { f[0], f[1], f[2], f[3] };
+    fe64_reduce(h);
+    platform_store64(s, h[0]);
+    platform_store64(s + 8, h[1]);
+    platform_store64(s + 16, h[2]);
+    platform_store64(s + 24, h[3]);
+}
+
+/*
+ * Adds top < 2^64 - 38 to h. If the sum overflows 2^256, the remainder is
+ * less than top, so adding 38 for the wrap-around can't overflow again.
+ */
+static FORCE_INLINE void fe64_fold(fe64 h, uint64_t top) {
+    uint128_t c;
+
+    c = (uint128_t)h[0] + top;
+    h[0] = (uint64_t)c;
+    c = (uint128_t)h[1] + (uint64_t)(c >> 64);
+    h[1] = (uint64_t)c;
+    c = (uint128_t)h[2] + (uint64_t)(c >> 64);
+    h[2] = (uint64_t)c;
+    c = (uint128_t)h[3] + (uint64_t)(c >> 64);
+    h[3] = (uint64_t)c;
+    h[0] += (uint64_t)(c >> 64) * 38;
+}
+
+/* Reduces the 512-bit product t[0..7] modulo 2^256-38. */
+static FORCE_INLINE void fe64_reduce512(fe64 h, const uint64_t t[8]) {
+    uint128_t c;
+
+    c = (uint128_t)t[4] * 38 + t[0];
+    h[0] = (uint64_t)c;
+    c = (uint128_t)t[5] * 38 + t[1] + (uint64_t)(c >> 64);
+    h[1] = (uint64_t)c;
+    c = (uint128_t)t[6] * 38 + t[2] + (uint64_t)(c >> 64);
+    h[2] = (uint64_t)c;
+    c = (uint128_t)t[7] * 38 + t[3] + (uint64_t)(c >> 64);
+    h[3] = (uint64_t)c;
+
+    /* top < 2^11 */
+    fe64_fold(h, (uint64_t)(c >> 64) * 38);
+}
+
+static FORCE_INLINE void fe64_mul(fe64 h, const fe64 f, const fe64 g) {
+    uint64_t t[8];
+    uint128_t c;
+    int i, j;
+
+    for (i = 0; i < 8; ++i) {
+        t[i] = 0;
+    }
+    for (i = 0; i < 4; ++i) {
+        uint64_t carry = 0;
+        for (j = 0; j < 4; ++j) {
+            c = (uint128_t)f[i] * g[j] + t[i + j] + carry;
+            t[i + j] = (uint64_t)c;
+            carry = (uint64_t)(c >> 64);
+        }
+        t[i + 4] = carry;
+    }
+    fe64_reduce512(h, t);
+}
+
+static FORCE_INLINE void fe64_sq(fe64 h, const fe64 f) {
+    uint64_t t[8];
+    uint128_t c, d;
+    uint64_t carry;
+    int i, j;
+
+    /* off-diagonal products f[i] f[j] with i < j */
+    for (i = 0; i < 8; ++i) {
+        t[i] = 0;
+    }
+    for (i = 0; i < 3; ++i) {
+        carry = 0;
+        for (j = i + 1; j < 4; ++j) {
+            c = (uint128_t)f[i] * f[j] + t[i + j] + carry;
+            t[i + j] = (uint64_t)c;
+            carry = (uint64_t)(c >> 64);
+        }
+        t[i + 4] = carry;
+    }
+    /* double them */
+    for (i = 7; i > 0; --i) {
+        t[i] = (t[i] << 1) | (t[i - 1] >> 63);
+    }
+    t[0] <<= 1;
+    /* add the squares f[i]^2 */
+    carry = 0;
+    for (i = 0; i < 4; ++i) {
+        c = (uint128_t)f[i] * f[i];
+        d = (uint128_t)t[2 * i] + (uint64_t)c + carry;
+        t[2 * i] = (uint64_t)d;
+        d = (uint128_t)t[2 * i + 1] + (uint64_t)(c >> 64) + (uint64_t)(d >> 64);
+        t[2 * i + 1] = (uint64_t)d;
+        carry = (uint64_t)(d >> 64);
+    }
+    fe64_reduce512(h, t);
+}
+
+static FORCE_INLINE void fe64_add(fe64 h, const fe64 f, const fe64 g) {
+    uint128_t c;
+
+    c = (uint128_t)f[0] + g[0];
+    h[0] = (uint64_t)c;
+    c = (uint128_t)f[1] + g[1] + (uint64_t)(c >> 64);
+    h[1] = (uint64_t)c;
+    c = (uint128_t)f[2] + g[2] + (uint64_t)(c >> 64);
+    h[2] = (uint64_t)c;
+    c = (uint128_t)f[3] + g[3] + (uint64_t)(c >> 64);
+    h[3] = (uint64_t)c;
+    fe64_fold(h, (uint64_t)(c >> 64) * 38);
+}
+
+static FORCE_INLINE void fe64_sub(fe64 h, const fe64 f, const fe64 g) {
+    uint128_t c;
+    uint64_t borrow;
+
+    c = (uint128_t)f[0] - g[0];
+    h[0] = (uint64_t)c;
+    c = (uint128_t)f[1] - g[1] - (uint64_t)(c >> 127);
+    h[1] = (uint64_t)c;
+    c = (uint128_t)f[2] - g[2] - (uint64_t)(c >> 127);
+    h[2] = (uint64_t)c;
+    c = (uint128_t)f[3] - g[3] - (uint64_t)(c >> 127);
+    h[3] = (uint64_t)c;
+    borrow = (uint64_t)(c >> 127) * 38;
+
+    /* subtract 38 for the wrap-around; if that wraps again, h[0] >= 2^64-38 */
+    c = (uint128_t)h[0] - borrow;
+    h[0] = (uint64_t)c;
+    c = (uint128_t)h[1] - (uint64_t)(c >> 127);
+    h[1] = (uint64_t)c;
+    c = (uint128_t)h[2] - (uint64_t)(c >> 127);
+    h[2] = (uint64_t)c;
+    c = (uint128_t)h[3] - (uint64_t)(c >> 127);
+    h[3] = (uint64_t)c;
+    h[0] -= (uint64_t)(c >> 127) * 38;
+}
+
+/* h = f * g, g < 2^32 */
+static FORCE_INLINE void fe64_mul_small(fe64 h, const fe64 f, uint64_t g) {
+    uint128_t c;
+
+    c = (uint128_t)f[0] * g;
+    h[0] = (uint64_t)c;
+    c = (uint128_t)f[1] * g + (uint64_t)(c >> 64);
+    h[1] = (uint64_t)c;
+    c = (uint128_t)f[2] * g + (uint64_t)(c >> 64);
+    h[2] = (uint64_t)c;
+    c = (uint128_t)f[3] * g + (uint64_t)(c >> 64);
+    h[3] = (uint64_t)c;
+    fe64_fold(h, (uint64_t)(c >> 64) * 38);
+}
+
+/* Swaps f and g if b = 1, does nothing if b = 0. */
+static FORCE_INLINE void fe64_cswap(fe64 f, fe64 g, unsigned int b) {
+    uint64_t mask = 0 - (uint64_t)b;
+    uint64_t x;
+    int i;
+
+    for (i = 0; i < 4; ++i) {
+        x = (f[i] ^ g[i]) & mask;
+        f[i] ^= x;
+        g[i] ^= x;
+    }
+}
+
+/*
+ * Constant-time inversion using the "safegcd" algorithm of Bernstein and Yang
+ * (https://eprint.iacr.org/2019/266) in the variant with 590 divsteps
+ * (10 batches of 59), which suffices for any 256-bit modulus. Intermediate
+ * values use 5 signed 62-bit limbs.
+ *
+ * The input does not have to be reduced. Inverting zero returns zero.
+ */
+
+typedef struct fe64_signed62 {
+    int64_t v[5];
+} fe64_signed62;
+
+typedef struct fe64_trans2x2 {
+    int64_t u, v, q, r;
+} fe64_trans2x2;
+
+#define FE64_M62 (UINT64_MAX >> 2)
+
+/* 2^255-19 = -19 + 128 * 2^248 */
+static const fe64_signed62 fe64_modulus62 = { { -19, 0, 0, 0, 128 } };
+
+/* (2^255-19)^-1 mod 2^62 */
+static const uint64_t fe64_modulus_inv62 = 0x39435e50d79435e5;
+
+/*
+ * Performs 59 divsteps on the low bits of f and g. Returns the new value of
+ * zeta = -(delta+1/2) and the transition matrix scaled by 2^62.
+ */
+static int64_t fe64_divsteps_59(int64_t zeta, uint64_t f0, uint64_t g0,
+    fe64_trans2x2* t)
+{
+    /* the matrix starts as the identity times 8 because the loop does 59 steps */
+    uint64_t u = 8, v = 0, q = 0, r = 8;
+    uint64_t mask1, mask2, f = f0, g = g0, x, y, z;
+    int i;
+
+    for (i = 3; i < 62; ++i) {
+        /* mask1 = -(zeta < 0), mask2 = -(g & 1) */
+        mask1 = (uint64_t)(zeta >> 63);
+        mask2 = 0 - (g & 1);
+        /* conditionally negate f, u, v */
+        x = (f ^ mask1) - mask1;
+        y = (u ^ mask1) - mask1;
+        z = (v ^ mask1) - mask1;
+        /* if g is odd, add them to g, q, r */
+        g += x & mask2;
+        q += y & mask2;
+        r += z & mask2;
+        /* swap case: zeta < 0 and g odd */
+        mask1 &= mask2;
+        zeta = (zeta ^ (int64_t)mask1) - 1;
+        f += g & mask1;
+        u += q & mask1;
+        v += r & mask1;
+        g >>= 1;
+        u <<= 1;
+        v <<= 1;
+    }
+    t->u = (int64_t)u;
+    t->v = (int64_t)v;
+    t->q = (int64_t)q;
+    t->r = (int64_t)r;
+    return zeta;
+}
+
+/*
+ * Computes (t [d, e]) / 2^62 mod p. The inputs and outputs are
+ * in the range (-2p, p).
+ */
+static void fe64_update_de_62(fe64_signed62* d, fe64_signed62* e,
+    const fe64_trans2x2* t)
+{
+    const int64_t d0 = d->v[0], d1 = d->v[1], d2 = d->v[2], d3 = d->v[3], d4 = d->v[4];
+    const int64_t e0 = e->v[0], e1 = e->v[1], e2 = e->v[2], e3 = e->v[3], e4 = e->v[4];
+    const int64_t u = t->u, v = t->v, q = t->q, r = t->r;
+    int64_t md, me, sd, se;
+    int128_t cd, ce;
+
+    /* md, me = [u, q] if d < 0, plus [v, r] if e < 0 */
+    sd = d4 >> 63;
+    se = e4 >> 63;
+    md = (u & sd) + (v & se);
+    me = (q & sd) + (r & se);
+    cd = (int128_t)u * d0 + (int128_t)v * e0;
+    ce = (int128_t)q * d0 + (int128_t)r * e0;
+    /* choose md, me so that the bottom 62 bits of t [d, e] + p [md, me] are zero */
+    md -= (fe64_modulus_inv62 * (uint64_t)cd + md) & FE64_M62;
+    me -= (fe64_modulus_inv62 * (uint64_t)ce + me) & FE64_M62;
+    cd += (int128_t)fe64_modulus62.v[0] * md;
+    ce += (int128_t)fe64_modulus62.v[0] * me;
+    cd >>= 62;
+    ce >>= 62;
+    /* limbs 1-3 of p are zero */
+    cd += (int128_t)u * d1 + (int128_t)v * e1;
+    ce += (int128_t)q * d1 + (int128_t)r * e1;
+    d->v[0] = (int64_t)((uint64_t)cd & FE64_M62);
+    e->v[0] = (int64_t)((uint64_t)ce & FE64_M62);
+    cd >>= 62;
+    ce >>= 62;
+    cd += (int128_t)u * d2 + (int128_t)v * e2;
+    ce += (int128_t)q * d2 + (int128_t)r * e2;
+    d->v[1] = (int64_t)((uint64_t)cd & FE64_M62);
+    e->v[1] = (int64_t)((uint64_t)ce & FE64_M62);
+    cd >>= 62;
+    ce >>= 62;
+    cd += (int128_t)u * d3 + (int128_t)v * e3;
+    ce += (int128_t)q * d3 + (int128_t)r * e3;
+    d->v[2] = (int64_t)((uint64_t)cd & FE64_M62);
+    e->v[2] = (int64_t)((uint64_t)ce & FE64_M62);
+    cd >>= 62;
+    ce >>= 62;
+    cd += (int128_t)u * d4 + (int128_t)v * e4;
+    ce += (int128_t)q * d4 + (int128_t)r * e4;
+    cd += (int128_t)fe64_modulus62.v[4] * md;
+    ce += (int128_t)fe64_modulus62.v[4] * me;
+    d->v[3] = (int64_t)((uint64_t)cd & FE64_M62);
+    e->v[3] = (int64_t)((uint64_t)ce & FE64_M62);
+    cd >>= 62;
+    ce >>= 62;
+    d->v[4] = (int64_t)cd;
+    e->v[4] = (int64_t)ce;
+}
+
+/* Computes (t [f, g]) / 2^62. The division is exact. */
+static void fe64_update_fg_62(fe64_signed62* f, fe64_signed62* g,
+    const fe64_trans2x2* t)
+{
+    const int64_t f0 = f->v[0], f1 = f->v[1], f2 = f->v[2], f3 = f->v[3], f4 = f->v[4];
+    const int64_t g0 = g->v[0], g1 = g->v[1], g2 = g->v[2], g3 = g->v[3], g4 = g->v[4];
+    const int64_t u = t->u, v = t->v, q = t->q, r = t->r;
+    int128_t cf, cg;
+
+    cf = (int128_t)u * f0 + (int128_t)v * g0;
+    cg = (int128_t)q * f0 + (int128_t)r * g0;
+    cf >>= 62;
+    cg >>= 62;
+    cf += (int128_t)u * f1 + (int128_t)v * g1;
+    cg += (int128_t)q * f1 + (int128_t)r * g1;
+    f->v[0] = (int64_t)((uint64_t)cf & FE64_M62);
+    g->v[0] = (int64_t)((uint64_t)cg & FE64_M62);
+    cf >>= 62;
+    cg >>= 62;
+    cf += (int128_t)u * f2 + (int128_t)v * g2;
+    cg += (int128_t)q * f2 + (int128_t)r * g2;
+    f->v[1] = (int64_t)((uint64_t)cf & FE64_M62);
+    g->v[1] = (int64_t)((uint64_t)cg & FE64_M62);
+    cf >>= 62;
+    cg >>= 62;
+    cf += (int128_t)u * f3 + (int128_t)v * g3;
+    cg += (int128_t)q * f3 + (int128_t)r * g3;
+    f->v[2] = (int64_t)((uint64_t)cf & FE64_M62);
+    g->v[2] = (int64_t)((uint64_t)cg & FE64_M62);
+    cf >>= 62;
+    cg >>= 62;
+    cf += (int128_t)u * f4 + (int128_t)v * g4;
+    cg += (int128_t)q * f4 + (int128_t)r * g4;
+    f->v[3] = (int64_t)((uint64_t)cf & FE64_M62);
+    g->v[3] = (int64_t)((uint64_t)cg & FE64_M62);
+    cf >>= 62;
+    cg >>= 62;
+    f->v[4] = (int64_t)cf;
+    g->v[4] = (int64_t)cg;
+}
+
+/*
+ * Brings r from the range (-2p, p) to [0, p) and negates it if sign < 0.
+ */
+static void fe64_normalize_62(fe64_signed62* r, int64_t sign) {
+    const int64_t M62 = (int64_t)FE64_M62;
+    int64_t r0 = r->v[0], r1 = r->v[1], r2 = r->v[2], r3 = r->v[3], r4 = r->v[4];
+    int64_t cond_add, cond_negate;
+
+    /* (-2p, p) -> (-p, p) */
+    cond_add = r4 >> 63;
+    r0 += fe64_modulus62.v[0] & cond_add;
+    r4 += fe64_modulus62.v[4] & cond_add;
+    cond_negate = sign >> 63;
+    r0 = (r0 ^ cond_negate) - cond_negate;
+    r1 = (r1 ^ cond_negate) - cond_negate;
+    r2 = (r2 ^ cond_negate) - cond_negate;
+    r3 = (r3 ^ cond_negate) - cond_negate;
+    r4 = (r4 ^ cond_negate) - cond_negate;
+    r1 += r0 >> 62; r0 &= M62;
+    r2 += r1 >> 62; r1 &= M62;
+    r3 += r2 >> 62; r2 &= M62;
+    r4 += r3 >> 62; r3 &= M62;
+
+    /* (-p, p) -> [0, p) */
+    cond_add = r4 >> 63;
+    r0 += fe64_modulus62.v[0] & cond_add;
+    r4 += fe64_modulus62.v[4] & cond_add;
+    r1 += r0 >> 62; r0 &= M62;
+    r2 += r1 >> 62; r1 &= M62;
+    r3 += r2 >> 62; r2 &= M62;
+    r4 += r3 >> 62; r3 &= M62;
+
+    r->v[0] = r0;
+    r->v[1] = r1;
+    r->v[2] = r2;
+    r->v[3] = r3;
+    r->v[4] = r4;
+}
+
+static void fe64_invert(fe64 out, const fe64 z) {
+    fe64_signed62 d = { { 0, 0, 0, 0, 0 } };
+    fe64_signed62 e = { { 1, 0, 0, 0, 0 } };
+    fe64_signed62 f = fe64_modulus62;
+    fe64_signed62 g;
+    fe64 x = { z[0], z[1], z[2], z[3] };
+    int64_t zeta = -1; /* delta = 1/2 */
+    int i;
+
+    fe64_reduce(x);
+    g.v[0] = (int64_t)(x[0] & FE64_M62);
+    g.v[1] = (int64_t)(((x[0] >> 62) | (x[1] << 2)) & FE64_M62);
+    g.v[2] = (int64_t)(((x[1] >> 60) | (x[2] << 4)) & FE64_M62);
+    g.v[3] = (int64_t)(((x[2] >> 58) | (x[3] << 6)) & FE64_M62);
+    g.v[4] = (int64_t)(x[3] >> 56);
+
+    for (i = 0; i < 10; ++i) {
+        fe64_trans2x2 t;
+        zeta = fe64_divsteps_59(zeta, (uint64_t)f.v[0], (uint64_t)g.v[0], &t);
+        fe64_update_de_62(&d, &e, &t);
+        fe64_update_fg_62(&f, &g, &t);
+    }
+
+    /* g = 0 and f = +-1 (or f = p when z = 0, in which case d = 0) */
+    fe64_normalize_62(&d, f.v[4]);
+
+    out[0] = (uint64_t)d.v[0] | ((uint64_t)d.v[1] << 62);
+    out[1] = ((uint64_t)d.v[1] >> 2) | ((uint64_t)d.v[2] << 60);
+    out[2] = ((uint64_t)d.v[2] >> 4) | ((uint64_t)d.v[3] << 58);
+    out[3] = ((uint64_t)d.v[3] >> 6) | ((uint64_t)d.v[4] << 56);
+}
+
+#endif
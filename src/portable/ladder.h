@@ -0,0 +1,199 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+#ifndef PORTABLE_LADDER_H
+#define PORTABLE_LADDER_H
+
+#include "fe.h"
+
+#include <stddef.h>
+
+/*
+ * Conditionally swaps (x2:z2) with (x3:z3) and calculates the ladder inputs
+ * A = x2 + z2, B = x2 - z2, C = x3 + z3, D = x3 - z3 in one pass. The
+ * swapped values are not stored because the step overwrites them anyway.
+ * The outputs may overlap the inputs. swap must be 0 or 1.
+ *
+ * If |x2|,|z2|,|x3|,|z3| are bounded by 1.1*2^25,1.1*2^24,..., then
+ * |a|,|b|,|c|,|d| are bounded by 1.1*2^26,1.1*2^25,...
+ */
+static void ladder_swap_addsub(fe a, fe b, fe c, fe d,
+    fe x2, fe z2, fe x3, fe z3, unsigned int swap)
+{
+    int32_t mask = -(int32_t)swap;
+    int32_t x2_0 = x2[0];
+    int32_t x2_1 = x2[1];
+    int32_t x2_2 = x2[2];
+    int32_t x2_3 = x2[3];
+    int32_t x2_4 = x2[4];
+    int32_t x2_5 = x2[5];
+    int32_t x2_6 = x2[6];
+    int32_t x2_7 = x2[7];
+    int32_t x2_8 = x2[8];
+    int32_t x2_9 = x2[9];
+    int32_t z2_0 = z2[0];
+    int32_t z2_1 = z2[1];
+    int32_t z2_2 = z2[2];
+    int32_t z2_3 = z2[3];
+    int32_t z2_4 = z2[4];
+    int32_t z2_5 = z2[5];
+    int32_t z2_6 = z2[6];
+    int32_t z2_7 = z2[7];
+    int32_t z2_8 = z2[8];
+    int32_t z2_9 = z2[9];
+    int32_t x3_0 = x3[0];
+    int32_t x3_1 = x3[1];
+    int32_t x3_2 = x3[2];
+    int32_t x3_3 = x3[3];
+    int32_t x3_4 = x3[4];
+    int32_t x3_5 = x3[5];
+    int32_t x3_6 = x3[6];
+    int32_t x3_7 = x3[7];
+    int32_t x3_8 = x3[8];
+    int32_t x3_9 = x3[9];
+    int32_t z3_0 = z3[0];
+    int32_t z3_1 = z3[1];
+    int32_t z3_2 = z3[2];
+    int32_t z3_3 = z3[3];
+    int32_t z3_4 = z3[4];
+    int32_t z3_5 = z3[5];
+    int32_t z3_6 = z3[6];
+    int32_t z3_7 = z3[7];
+    int32_t z3_8 = z3[8];
+    int32_t z3_9 = z3[9];
+    int32_t tx0 = (x2_0 ^ x3_0) & mask;
+    int32_t tx1 = (x2_1 ^ x3_1) & mask;
+    int32_t tx2 = (x2_2 ^ x3_2) & mask;
+    int32_t tx3 = (x2_3 ^ x3_3) & mask;
+    int32_t tx4 = (x2_4 ^ x3_4) & mask;
+    int32_t tx5 = (x2_5 ^ x3_5) & mask;
+    int32_t tx6 = (x2_6 ^ x3_6) & mask;
+    int32_t tx7 = (x2_7 ^ x3_7) & mask;
+    int32_t tx8 = (x2_8 ^ x3_8) & mask;
+    int32_t tx9 = (x2_9 ^ x3_9) & mask;
+    int32_t tz0 = (z2_0 ^ z3_0) & mask;
+    int32_t tz1 = (z2_1 ^ z3_1) & mask;
+    int32_t tz2 = (z2_2 ^ z3_2) & mask;
+    int32_t tz3 = (z2_3 ^ z3_3) & mask;
+    int32_t tz4 = (z2_4 ^ z3_4) & mask;
+    int32_t tz5 = (z2_5 ^ z3_5) & mask;
+    int32_t tz6 = (z2_6 ^ z3_6) & mask;
+    int32_t tz7 = (z2_7 ^ z3_7) & mask;
+    int32_t tz8 = (z2_8 ^ z3_8) & mask;
+    int32_t tz9 = (z2_9 ^ z3_9) & mask;
+
+    x2_0 ^= tx0; x3_0 ^= tx0;
+    x2_1 ^= tx1; x3_1 ^= tx1;
+    x2_2 ^= tx2; x3_2 ^= tx2;
+    x2_3 ^= tx3; x3_3 ^= tx3;
+    x2_4 ^= tx4; x3_4 ^= tx4;
+    x2_5 ^= tx5; x3_5 ^= tx5;
+    x2_6 ^= tx6; x3_6 ^= tx6;
+    x2_7 ^= tx7; x3_7 ^= tx7;
+    x2_8 ^= tx8; x3_8 ^= tx8;
+    x2_9 ^= tx9; x3_9 ^= tx9;
+    z2_0 ^= tz0; z3_0 ^= tz0;
+    z2_1 ^= tz1; z3_1 ^= tz1;
+    z2_2 ^= tz2; z3_2 ^= tz2;
+    z2_3 ^= tz3; z3_3 ^= tz3;
+    z2_4 ^= tz4; z3_4 ^= tz4;
+    z2_5 ^= tz5; z3_5 ^= tz5;
+    z2_6 ^= tz6; z3_6 ^= tz6;
+    z2_7 ^= tz7; z3_7 ^= tz7;
+    z2_8 ^= tz8; z3_8 ^= tz8;
+    z2_9 ^= tz9; z3_9 ^= tz9;
+
+    a[0] = x2_0 + z2_0;
+    a[1] = x2_1 + z2_1;
+    a[2] = x2_2 + z2_2;
+    a[3] = x2_3 + z2_3;
+    a[4] = x2_4 + z2_4;
+    a[5] = x2_5 + z2_5;
+    a[6] = x2_6 + z2_6;
+    a[7] = x2_7 + z2_7;
+    a[8] = x2_8 + z2_8;
+    a[9] = x2_9 + z2_9;
+    b[0] = x2_0 - z2_0;
+    b[1] = x2_1 - z2_1;
+    b[2] = x2_2 - z2_2;
+    b[3] = x2_3 - z2_3;
+    b[4] = x2_4 - z2_4;
+    b[5] = x2_5 - z2_5;
+    b[6] = x2_6 - z2_6;
+    b[7] = x2_7 - z2_7;
+    b[8] = x2_8 - z2_8;
+    b[9] = x2_9 - z2_9;
+    c[0] = x3_0 + z3_0;
+    c[1] = x3_1 + z3_1;
+    c[2] = x3_2 + z3_2;
+    c[3] = x3_3 + z3_3;
+    c[4] = x3_4 + z3_4;
+    c[5] = x3_5 + z3_5;
+    c[6] = x3_6 + z3_6;
+    c[7] = x3_7 + z3_7;
+    c[8] = x3_8 + z3_8;
+    c[9] = x3_9 + z3_9;
+    d[0] = x3_0 - z3_0;
+    d[1] = x3_1 - z3_1;
+    d[2] = x3_2 - z3_2;
+    d[3] = x3_3 - z3_3;
+    d[4] = x3_4 - z3_4;
+    d[5] = x3_5 - z3_5;
+    d[6] = x3_6 - z3_6;
+    d[7] = x3_7 - z3_7;
+    d[8] = x3_8 - z3_8;
+    d[9] = x3_9 - z3_9;
+}
+
+/*
+ * One Montgomery ladder step for the key bit b. The conditional swap is
+ * deferred: *swap holds the bit of the previous step and the caller must
+ * do a final fe_cswap2 with it after the last step.
+ *
+ * If x1 is NULL, the base point u = 9 is used and the multiplication by x1
+ * becomes a small-constant multiplication.
+ *
+ * The step is fused: the swap of both pairs and the four additions are
+ * done in one pass and the multiplication by 121666 is merged with the
+ * following addition. Additions and subtractions are never carried, the
+ * bounds below show that every input stays within the preconditions of
+ * fe.h. All values at the start of a step are outputs of fe_mul, fe_sq or
+ * fe_mul_small, or the initial values of the ladder, so they are bounded
+ * by 1.1*2^25,1.1*2^24,... ("carried"). Sums and differences of carried
+ * values are bounded by 1.1*2^26,1.1*2^25,... ("uncarried"), which is what
+ * fe_mul and fe_sq accept.
+ */
+static void ladder_step(fe x1, fe x2, fe z2, fe x3, fe z3,
+    unsigned int* swap, unsigned int b)
+{
+    fe tmp0;
+    fe tmp1;
+
+    *swap ^= b;
+    /* x2 = A, tmp1 = B, z2 = C, tmp0 = D, all uncarried */
+    ladder_swap_addsub(x2, tmp1, z2, tmp0, x2, z2, x3, z3, *swap);
+    *swap = b;
+
+    fe_mul(z3, tmp0, x2);               /* DA, carried */
+    fe_mul(z2, z2, tmp1);               /* CB, carried */
+    fe_sq(tmp0, tmp1);                  /* BB, carried */
+    fe_sq(tmp1, x2);                    /* AA, carried */
+    fe_addsub(x3, z2, z3, z2);          /* DA + CB, DA - CB, uncarried */
+    fe_mul(x2, tmp1, tmp0);             /* x2 = AA * BB */
+    fe_sub(tmp1, tmp1, tmp0);           /* E = AA - BB, uncarried */
+    fe_sq(z2, z2);                      /* (DA - CB)^2, carried */
+    fe_sq(x3, x3);                      /* x3 = (DA + CB)^2 */
+    fe_mul121666_add(tmp0, tmp1, tmp0); /* BB + 121666 * E, carried */
+    if (x1 != NULL) {
+        fe_mul(z3, x1, z2);             /* z3 = x1 * (DA - CB)^2 */
+    }
+    else {
+        fe_mul_small(z3, z2, 9);
+    }
+    fe_mul(z2, tmp1, tmp0);             /* z2 = E * (BB + 121666 * E) */
+}
+
+#endif
@@ -0,0 +1,52 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+#ifndef PORTABLE_LADDER64_H
+#define PORTABLE_LADDER64_H
+
+#include "fe64.h"
+
+#include <stddef.h>
+
+/* the multiplication by x1 becomes a multiplication by 9 if x1 is NULL */
+static void ladder64_step(const uint64_t* x1,
+    fe64 x2, fe64 z2, fe64 x3, fe64 z3, unsigned int* swap, unsigned int b)
+{
+    fe64 tmp0;
+    fe64 tmp1;
+
+    *swap ^= b;
+    fe64_cswap(x2, x3, *swap);
+    fe64_cswap(z2, z3, *swap);
+    *swap = b;
+    fe64_sub(tmp0, x3, z3);
+
+    fe64_sub(tmp1, x2, z2);
+    fe64_add(x2, x2, z2);
+    fe64_add(z2, x3, z3);
+
+    fe64_mul(z3, tmp0, x2);
+    fe64_mul(z2, z2, tmp1);
+    fe64_sq(tmp0, tmp1);
+    fe64_sq(tmp1, x2);
+    fe64_add(x3, z3, z2);
+    fe64_sub(z2, z3, z2);
+    fe64_mul(x2, tmp1, tmp0);
+    fe64_sub(tmp1, tmp1, tmp0);
+    fe64_sq(z2, z2);
+    fe64_mul_small(z3, tmp1, 121666);
+    fe64_sq(x3, x3);
+    fe64_add(tmp0, tmp0, z3);
+    if (x1 != NULL) {
+        fe64_mul(z3, x1, z2);
+    }
+    else {
+        fe64_mul_small(z3, z2, 9);
+    }
+    fe64_mul(z2, tmp1, tmp0);
+}
+
+#endif
@@ -0,0 +1,182 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+#include "point.h"
+#include "fe.h"
+#include "../platform.h"
+#include "../trace.h"
+#ifdef PLATFORM_UINT128
+#include "fe64.h"
+#endif
+
+/* maximum number of elements normalized with one inversion */
+#define NORMALIZE_CHUNK 32
+
+/* 2A = 973324 */
+static const uint8_t curve_2a[32] = { 0x0c, 0xda, 0x0e };
+
+/* like fe_frombytes, but bit 255 is not ignored */
+static void fe_frombytes256(fe h, const uint8_t* s) {
+    fe_frombytes(h, s);
+    h[0] += 19 * (s[31] >> 7);
+}
+
+/* returns 1 if h = 0 (mod 2^255-19), otherwise 0 */
+static unsigned int fe_iszero(fe h) {
+    uint8_t s[32];
+    unsigned int r = 0;
+    int i;
+
+    fe_tobytes(s, h);
+    for (i = 0; i < 32; ++i) {
+        r |= s[i];
+    }
+    return ((r - 1) >> 8) & 1;
+}
+
+/* uses the safegcd inversion where available, which is ~4x faster */
+static void fe_invert_fast(fe out, fe z) {
+#ifdef PLATFORM_UINT128
+    uint8_t s[32];
+    fe64 t;
+
+    fe_tobytes(s, z);
+    fe64_frombytes(t, s);
+    fe64_invert(t, t);
+    fe64_tobytes(s, t);
+    fe_frombytes(out, s);
+#else
+    fe_invert(out, z);
+#endif
+}
+
+/*
+ * Okeya-Sakurai y-coordinate recovery for the curve v^2 = u^3 + A u^2 + u.
+ * See "Efficient Elliptic Curve Cryptosystems from a Scalar Multiplication
+ * Algorithm with Recovery of the y-Coordinate on a Montgomery-Form Elliptic
+ * Curve" (CHES 2001), algorithm 1.
+ */
+void mx25519_point_recover(uint8_t* u, uint8_t* v,
+    const uint8_t* xz,
+    const uint8_t* pu,
+    const uint8_t* pv)
+{
+    fe x, y;
+    fe x2, z2, x3, z3;
+    fe a2;
+    fe t1, t2, t3, t4;
+
+    fe_frombytes(x, pu);
+    fe_frombytes(y, pv);
+    fe_frombytes256(x2, xz);
+    fe_frombytes256(z2, xz + 32);
+    fe_frombytes256(x3, xz + 64);
+    fe_frombytes256(z3, xz + 96);
+    fe_frombytes(a2, curve_2a);
+
+    fe_mul(t1, x, z2);     /* t1 = x Z2 */
+    fe_add(t2, x2, t1);    /* t2 = X2 + x Z2 */
+    fe_sub(t3, x2, t1);
+    fe_sq(t3, t3);
+    fe_mul(t3, t3, x3);    /* t3 = (X2 - x Z2)^2 X3 */
+    fe_mul(t1, a2, z2);    /* t1 = 2A Z2 */
+    fe_add(t2, t2, t1);    /* t2 = X2 + x Z2 + 2A Z2 */
+    fe_mul(t4, x, x2);
+    fe_add(t4, t4, z2);    /* t4 = x X2 + Z2 */
+    fe_mul(t2, t2, t4);
+    fe_mul(t1, t1, z2);
+    fe_sub(t2, t2, t1);
+    fe_mul(t2, t2, z3);
+    fe_sub(t2, t2, t3);    /* t2 = Y' */
+    fe_add(t1, y, y);      /* t1 = 2 B y, B = 1 */
+    fe_mul(t1, t1, z2);
+    fe_mul(t1, t1, z3);
+    fe_mul(t3, t1, x2);    /* t3 = X' */
+    fe_mul(t4, t1, z2);    /* t4 = Z' */
+
+    TRACE_PROBE1(invert__entry, 1);
+    fe_invert_fast(t4, t4);
+    TRACE_PROBE1(invert__exit, 1);
+    fe_mul(t3, t3, t4);
+    fe_mul(t2, t2, t4);
+    fe_tobytes(u, t3);
+    fe_tobytes(v, t2);
+}
+
+/* loads (X:Z) and replaces it with (0:1) if Z = 0 */
+static void load_xz(fe x, fe z, const uint8_t* xz) {
+    fe t;
+    unsigned int zero;
+
+    fe_frombytes256(x, xz);
+    fe_frombytes256(z, xz + 32);
+    zero = fe_iszero(z);
+    fe_0(t);
+    fe_cswap(x, t, zero);
+    fe_1(t);
+    fe_cswap(z, t, zero);
+}
+
+void mx25519_point_normalize(uint8_t* out, const uint8_t* xz, size_t stride,
+    size_t count)
+{
+    fe acc[NORMALIZE_CHUNK];
+    fe x, z, inv, t;
+    size_t i, n;
+
+    while (count > 0) {
+        n = count < NORMALIZE_CHUNK ? count : NORMALIZE_CHUNK;
+
+        /* acc[i] = Z[0] * ... * Z[i] */
+        load_xz(x, acc[0], xz);
+        for (i = 1; i < n; ++i) {
+            load_xz(x, z, xz + i * stride);
+            fe_mul(acc[i], acc[i - 1], z);
+        }
+
+        TRACE_PROBE1(invert__entry, n);
+        fe_invert_fast(inv, acc[n - 1]);
+        TRACE_PROBE1(invert__exit, n);
+
+        /* inv = 1 / (Z[0] * ... * Z[i]) */
+        for (i = n - 1; i > 0; --i) {
+            load_xz(x, z, xz + i * stride);
+            fe_mul(t, inv, acc[i - 1]);
+            fe_mul(inv, inv, z);
+            fe_mul(x, x, t);
+            fe_tobytes(out + 32 * i, x);
+        }
+        load_xz(x, z, xz);
+        fe_mul(x, x, inv);
+        fe_tobytes(out, x);
+
+        out += 32 * n;
+        xz += stride * n;
+        count -= n;
+    }
+}
+
+int mx25519_point_equals(const uint8_t* u, const uint8_t* xz)
+{
+    fe x, z, t;
+    uint8_t s[32];
+    unsigned int diff = 0;
+    int i;
+
+    load_xz(x, z, xz);
+
+    /* the normalized value is always canonical */
+    fe_frombytes(t, u);
+    fe_tobytes(s, t);
+    for (i = 0; i < 32; ++i) {
+        diff |= s[i] ^ u[i];
+    }
+
+    /* X = u * Z */
+    fe_mul(t, t, z);
+    fe_sub(t, x, t);
+    return fe_iszero(t) & ((diff - 1) >> 8);
+}
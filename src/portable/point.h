@@ -0,0 +1,38 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+#ifndef PORTABLE_POINT_H
+#define PORTABLE_POINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Recovers the affine point (u, v) = n*P from the projective ladder output
+ * xz = (X2, Z2, X3, Z3), where (X2:Z2) = x(n*P) and (X3:Z3) = x((n+1)*P).
+ * (pu, pv) are the affine coordinates of P.
+ */
+void mx25519_point_recover(uint8_t* u, uint8_t* v,
+    const uint8_t* xz,
+    const uint8_t* pu,
+    const uint8_t* pv);
+
+/*
+ * Calculates out[i] = X[i] / Z[i] for `count` projective x-coordinates using
+ * one inversion per up to 32 elements. Each (X[i], Z[i]) pair is stored as
+ * 2 consecutive 256-bit integers at xz + i * stride. Pairs with Z[i] = 0
+ * produce 0.
+ */
+void mx25519_point_normalize(uint8_t* out, const uint8_t* xz, size_t stride,
+    size_t count);
+
+/*
+ * Returns 1 if the projective x-coordinate (X, Z) stored at xz normalizes
+ * to the 32 bytes at u, otherwise 0. Constant time.
+ */
+int mx25519_point_equals(const uint8_t* u, const uint8_t* xz);
+
+#endif
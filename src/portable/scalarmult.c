@@ -6,8 +6,10 @@
 
 #include "scalarmult.h"
 #include "fe.h"
+#include "ladder.h"
 
-void mx25519_scalarmult_portable(uint8_t* q,
+/* (x2:z2) <- n*P, (x3:z3) <- (n+1)*P, P is the base point if p is NULL */
+static void ladder(fe x2, fe z2, fe x3, fe z3,
     const uint8_t* n,
     const uint8_t* p,
     const uint8_t clamp_lo,
@@ -16,12 +18,6 @@ void mx25519_scalarmult_portable(uint8_t* q,
     uint8_t e[32];
     unsigned int i;
     fe x1;
-    fe x2;
-    fe z2;
-    fe x3;
-    fe z3;
-    fe tmp0;
-    fe tmp1;
     int pos;
     unsigned int swap;
     unsigned int b;
@@ -30,45 +26,99 @@ void mx25519_scalarmult_portable(uint8_t* q,
     e[0] &= clamp_lo;
     e[31] |= clamp_hi;
     // bit 255 is cleared implicitly by virtue of ignoring it
-    fe_frombytes(x1, p);
     fe_1(x2);
     fe_0(z2);
-    fe_copy(x3, x1);
+    if (p != NULL) {
+        fe_frombytes(x1, p);
+        fe_copy(x3, x1);
+    }
+    else {
+        fe_0(x3);
+        x3[0] = 9;
+    }
     fe_1(z3);
 
     swap = 0;
     for (pos = 254; pos >= 0; --pos) {
         b = e[pos / 8] >> (pos & 7);
         b &= 1;
-        swap ^= b;
-        fe_cswap(x2, x3, swap);
-        fe_cswap(z2, z3, swap);
-        swap = b;
-        fe_sub(tmp0, x3, z3);
-
-        fe_sub(tmp1, x2, z2);
-        fe_add(x2, x2, z2);
-        fe_add(z2, x3, z3);
-
-        fe_mul(z3, tmp0, x2);
-        fe_mul(z2, z2, tmp1);
-        fe_sq(tmp0, tmp1);
-        fe_sq(tmp1, x2);
-        fe_add(x3, z3, z2);
-        fe_sub(z2, z3, z2);
-        fe_mul(x2, tmp1, tmp0);
-        fe_sub(tmp1, tmp1, tmp0);
-        fe_sq(z2, z2);
-        fe_mul121666(z3, tmp1);
-        fe_sq(x3, x3);
-        fe_add(tmp0, tmp0, z3);
-        fe_mul(z3, x1, z2);
-        fe_mul(z2, tmp1, tmp0);
+        ladder_step(p != NULL ? x1 : NULL, x2, z2, x3, z3, &swap, b);
     }
-    fe_cswap(x2, x3, swap);
-    fe_cswap(z2, z3, swap);
+    fe_cswap2(x2, x3, z2, z3, swap);
+}
+
+void mx25519_scalarmult_portable(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi)
+{
+    fe x2;
+    fe z2;
+    fe x3;
+    fe z3;
+
+    ladder(x2, z2, x3, z3, n, p, clamp_lo, clamp_hi);
+
+    fe_invert(z2, z2);
+    fe_mul(x2, x2, z2);
+    fe_tobytes(q, x2);
+}
+
+void mx25519_scalarmult_portable_base(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi)
+{
+    fe x2;
+    fe z2;
+    fe x3;
+    fe z3;
+
+    (void)p;
+    ladder(x2, z2, x3, z3, n, NULL, clamp_lo, clamp_hi);
 
     fe_invert(z2, z2);
     fe_mul(x2, x2, z2);
     fe_tobytes(q, x2);
 }
+
+void mx25519_ladder_portable(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi)
+{
+    fe x2;
+    fe z2;
+    fe x3;
+    fe z3;
+
+    ladder(x2, z2, x3, z3, n, p, clamp_lo, clamp_hi);
+
+    fe_tobytes(xz, x2);
+    fe_tobytes(xz + 32, z2);
+    fe_tobytes(xz + 64, x3);
+    fe_tobytes(xz + 96, z3);
+}
+
+void mx25519_ladder_portable_base(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    const uint8_t clamp_lo,
+    const uint8_t clamp_hi)
+{
+    fe x2;
+    fe z2;
+    fe x3;
+    fe z3;
+
+    (void)p;
+    ladder(x2, z2, x3, z3, n, NULL, clamp_lo, clamp_hi);
+
+    fe_tobytes(xz, x2);
+    fe_tobytes(xz + 32, z2);
+    fe_tobytes(xz + 64, x3);
+    fe_tobytes(xz + 96, z3);
+}
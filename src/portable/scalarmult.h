@@ -15,4 +15,24 @@ void mx25519_scalarmult_portable(uint8_t* q,
     uint8_t clamp_lo,
     uint8_t clamp_hi);
 
+/* p is ignored, the base point u = 9 is used */
+void mx25519_scalarmult_portable_base(uint8_t* q,
+    const uint8_t* n,
+    const uint8_t* p,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi);
+
+void mx25519_ladder_portable(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi);
+
+/* p is ignored, the base point u = 9 is used */
+void mx25519_ladder_portable_base(uint8_t* xz,
+    const uint8_t* n,
+    const uint8_t* p,
+    uint8_t clamp_lo,
+    uint8_t clamp_hi);
+
 #endif
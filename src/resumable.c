@@ -0,0 +1,166 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+#include <mx25519.h>
+
+#include "platform.h"
+#ifdef PLATFORM_UINT128
+#include "portable/ladder64.h"
+#else
+#include "portable/fe.h"
+#include "portable/ladder.h"
+#include "portable/point.h"
+#endif
+#include "trace.h"
+
+#include <assert.h>
+#include <string.h>
+
+/* number of ladder steps (key bits 254 ... 0) */
+#define LADDER_BITS 255
+
+/*
+ * The ladder uses 4 64-bit limbs where 128-bit products are available and
+ * the 10 limbs of ref10 otherwise.
+ */
+#ifdef PLATFORM_UINT128
+typedef fe64 scmul_fe;
+#else
+typedef fe scmul_fe;
+#endif
+
+typedef struct scmul_state {
+    scmul_fe x1;
+    scmul_fe x2;
+    scmul_fe z2;
+    scmul_fe x3;
+    scmul_fe z3;
+    uint8_t e[32];
+    unsigned int pos; /* number of remaining steps */
+    unsigned int swap;
+} scmul_state;
+
+/*
+ * The state is copied in and out of the context, which makes no assumptions
+ * about the alignment of the caller's buffer and doesn't access it through
+ * an incompatible type.
+ */
+
+/* fails to compile if the state doesn't fit into mx25519_scmul_ctx */
+typedef char scmul_state_size_check[
+    sizeof(scmul_state) <= sizeof(mx25519_scmul_ctx) ? 1 : -1];
+
+static void scmul_wipe(void* ptr, size_t size) {
+    volatile uint8_t* p = ptr;
+    while (size--) {
+        *p++ = 0;
+    }
+}
+
+void mx25519_scmul_begin(mx25519_scmul_ctx* ctx, const mx25519_privkey* key,
+    const mx25519_pubkey* p)
+{
+    scmul_state st;
+
+    assert(ctx != NULL);
+    assert(key != NULL);
+    assert(p != NULL);
+
+    TRACE_PROBE2(resumable__entry, TRACE_RESUMABLE_BEGIN, LADDER_BITS);
+    memcpy(st.e, key->data, sizeof(st.e));
+    st.e[0] &= 248;
+    st.e[31] |= 64;
+    /* bit 255 is cleared implicitly by virtue of ignoring it */
+#ifdef PLATFORM_UINT128
+    fe64_frombytes(st.x1, p->data);
+    memset(st.x2, 0, sizeof(st.x2));
+    memset(st.z2, 0, sizeof(st.z2));
+    memcpy(st.x3, st.x1, sizeof(st.x3));
+    memset(st.z3, 0, sizeof(st.z3));
+    st.x2[0] = 1;
+    st.z3[0] = 1;
+#else
+    fe_frombytes(st.x1, p->data);
+    fe_1(st.x2);
+    fe_0(st.z2);
+    fe_copy(st.x3, st.x1);
+    fe_1(st.z3);
+#endif
+    st.pos = LADDER_BITS;
+    st.swap = 0;
+    memcpy(ctx->opaque, &st, sizeof(st));
+    scmul_wipe(&st, sizeof(st));
+    TRACE_PROBE2(resumable__exit, TRACE_RESUMABLE_BEGIN, LADDER_BITS);
+}
+
+/* runs up to nbits ladder steps and returns the number of remaining steps */
+static unsigned scmul_run(scmul_state* st, unsigned nbits)
+{
+    unsigned int b;
+
+    /* the number of steps depends only on public values */
+    while (nbits > 0 && st->pos > 0) {
+        st->pos--;
+        b = st->e[st->pos / 8] >> (st->pos & 7);
+        b &= 1;
+#ifdef PLATFORM_UINT128
+        ladder64_step(st->x1, st->x2, st->z2, st->x3, st->z3, &st->swap, b);
+#else
+        ladder_step(st->x1, st->x2, st->z2, st->x3, st->z3, &st->swap, b);
+#endif
+        nbits--;
+    }
+    return st->pos;
+}
+
+unsigned mx25519_scmul_step(mx25519_scmul_ctx* ctx, unsigned nbits)
+{
+    scmul_state st;
+    unsigned remaining;
+
+    assert(ctx != NULL);
+    memcpy(&st, ctx->opaque, sizeof(st));
+    assert(st.pos <= LADDER_BITS);
+
+    TRACE_PROBE2(resumable__entry, TRACE_RESUMABLE_STEP, st.pos);
+    remaining = scmul_run(&st, nbits);
+    memcpy(ctx->opaque, &st, sizeof(st));
+    scmul_wipe(&st, sizeof(st));
+    TRACE_PROBE2(resumable__exit, TRACE_RESUMABLE_STEP, remaining);
+    return remaining;
+}
+
+void mx25519_scmul_finish(mx25519_scmul_ctx* ctx, mx25519_pubkey* result)
+{
+    scmul_state st;
+#ifndef PLATFORM_UINT128
+    uint8_t xz[64];
+#endif
+
+    assert(ctx != NULL);
+    assert(result != NULL);
+    memcpy(&st, ctx->opaque, sizeof(st));
+    assert(st.pos <= LADDER_BITS);
+
+    TRACE_PROBE2(resumable__entry, TRACE_RESUMABLE_FINISH, st.pos);
+    scmul_run(&st, LADDER_BITS);
+#ifdef PLATFORM_UINT128
+    fe64_cswap(st.x2, st.x3, st.swap);
+    fe64_cswap(st.z2, st.z3, st.swap);
+    fe64_invert(st.z2, st.z2);
+    fe64_mul(st.x2, st.x2, st.z2);
+    fe64_tobytes(result->data, st.x2);
+#else
+    fe_cswap2(st.x2, st.x3, st.z2, st.z3, st.swap);
+    fe_tobytes(xz, st.x2);
+    fe_tobytes(xz + 32, st.z2);
+    mx25519_point_normalize(result->data, xz, sizeof(xz), 1);
+    scmul_wipe(xz, sizeof(xz));
+#endif
+    scmul_wipe(&st, sizeof(st));
+    scmul_wipe(ctx, sizeof(*ctx));
+    TRACE_PROBE2(resumable__exit, TRACE_RESUMABLE_FINISH, 0);
+}
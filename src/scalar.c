@@ -0,0 +1,289 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+#include <mx25519.h>
+
+#include "trace.h"
+
+#include <assert.h>
+#include <stdint.h>
+
+/*
+ * Arithmetic modulo l = 2^252 + 27742317777372353535851937790883648493
+ * with 8x32-bit limbs and Montgomery multiplication (R = 2^256). Only
+ * 32x32->64-bit products are used, so the code is portable. All functions
+ * run in constant time.
+ */
+
+typedef uint32_t sc[8];
+
+/* number of scalars inverted with one exponentiation */
+#define SCALAR_BATCH_CHUNK 32
+
+static const sc sc_l = {
+    0x5cf5d3ed, 0x5812631a, 0xa2f79cd6, 0x14def9de,
+    0x00000000, 0x00000000, 0x00000000, 0x10000000
+};
+
+/* -1/l mod 2^32 */
+static const uint32_t sc_l_inv = 0x12547e1b;
+
+/* R mod l (1 in Montgomery form) */
+static const sc sc_r1 = {
+    0x8d98951d, 0xd6ec3174, 0x737dcf70, 0xc6ef5bf4,
+    0xfffffffe, 0xffffffff, 0xffffffff, 0x0fffffff
+};
+
+/* R^2 mod l */
+static const sc sc_r2 = {
+    0x449c0f01, 0xa40611e3, 0x68859347, 0xd00e1ba7,
+    0x17f5be65, 0xceec73d2, 0x7c309a3d, 0x0399411b
+};
+
+/* R^3 mod l */
+static const sc sc_r3 = {
+    0x7b83a2db, 0x2a9e4968, 0xaef7f3ec, 0x278324e6,
+    0x04ec5b65, 0x8065dc6c, 0x3599cec7, 0x0e530b77
+};
+
+/* l - 2, little endian */
+static const uint8_t sc_l_minus_2[32] = {
+    0xeb, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58,
+    0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10
+};
+
+static const sc sc_zero = { 0 };
+static const sc sc_one = { 1 };
+
+static void sc_load(sc r, const uint8_t* s) {
+    int i;
+    for (i = 0; i < 8; ++i) {
+        r[i] = (uint32_t)s[4 * i]
+            | (uint32_t)s[4 * i + 1] << 8
+            | (uint32_t)s[4 * i + 2] << 16
+            | (uint32_t)s[4 * i + 3] << 24;
+    }
+}
+
+static void sc_store(uint8_t* s, const sc a) {
+    int i;
+    for (i = 0; i < 8; ++i) {
+        s[4 * i] = (uint8_t)a[i];
+        s[4 * i + 1] = (uint8_t)(a[i] >> 8);
+        s[4 * i + 2] = (uint8_t)(a[i] >> 16);
+        s[4 * i + 3] = (uint8_t)(a[i] >> 24);
+    }
+}
+
+static void sc_copy(sc r, const sc a) {
+    int i;
+    for (i = 0; i < 8; ++i) {
+        r[i] = a[i];
+    }
+}
+
+/* r = a if mask = 0, r = b if mask = 0xffffffff */
+static void sc_select(sc r, const sc a, const sc b, uint32_t mask) {
+    int i;
+    for (i = 0; i < 8; ++i) {
+        r[i] = a[i] ^ (mask & (a[i] ^ b[i]));
+    }
+}
+
+/* returns 0xffffffff if a = 0, otherwise 0 */
+static uint32_t sc_zero_mask(const sc a) {
+    uint32_t x = 0;
+    int i;
+    for (i = 0; i < 8; ++i) {
+        x |= a[i];
+    }
+    return (uint32_t)(((uint64_t)x - 1) >> 32);
+}
+
+/* r = t mod l for t < 2l (t fits into 8 limbs because 2l < 2^254) */
+static void sc_reduce_once(sc r, const uint32_t t[8]) {
+    sc d;
+    uint64_t c = 0;
+    int i;
+
+    for (i = 0; i < 8; ++i) {
+        c = (uint64_t)t[i] - sc_l[i] - (c >> 63);
+        d[i] = (uint32_t)c;
+    }
+    /* keep t if the subtraction borrowed */
+    sc_select(r, d, t, 0 - (uint32_t)(c >> 63));
+}
+
+/*
+ * r = a * b / R mod l. Requires a < R and b < l, then the intermediate
+ * result is < 2l (< R) and one conditional subtraction suffices.
+ */
+static void sc_montmul(sc r, const sc a, const sc b) {
+    uint32_t t[10] = { 0 };
+    uint64_t c;
+    uint32_t m;
+    int i, j;
+
+    for (i = 0; i < 8; ++i) {
+        c = 0;
+        for (j = 0; j < 8; ++j) {
+            c += (uint64_t)a[j] * b[i] + t[j];
+            t[j] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[8];
+        t[8] = (uint32_t)c;
+        t[9] = (uint32_t)(c >> 32);
+
+        m = t[0] * sc_l_inv;
+        c = ((uint64_t)m * sc_l[0] + t[0]) >> 32;
+        for (j = 1; j < 8; ++j) {
+            c += (uint64_t)m * sc_l[j] + t[j];
+            t[j - 1] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[8];
+        t[7] = (uint32_t)c;
+        t[8] = t[9] + (uint32_t)(c >> 32);
+    }
+    sc_reduce_once(r, t);
+}
+
+/* r = a + b mod l for a, b < l */
+static void sc_add(sc r, const sc a, const sc b) {
+    sc t;
+    uint64_t c = 0;
+    int i;
+
+    for (i = 0; i < 8; ++i) {
+        c += (uint64_t)a[i] + b[i];
+        t[i] = (uint32_t)c;
+        c >>= 32;
+    }
+    sc_reduce_once(r, t);
+}
+
+/* r = x^(l-2) in the Montgomery domain, using 4-bit fixed windows */
+static void sc_pow_inv(sc r, const sc x) {
+    sc table[16];
+    sc acc;
+    int i, k;
+
+    sc_copy(table[0], sc_r1);
+    sc_copy(table[1], x);
+    for (i = 2; i < 16; ++i) {
+        sc_montmul(table[i], table[i - 1], x);
+    }
+
+    /* the exponent is public, so the table index may depend on it */
+    sc_copy(acc, table[sc_l_minus_2[31] >> 4]);
+    for (i = 62; i >= 0; --i) {
+        for (k = 0; k < 4; ++k) {
+            sc_montmul(acc, acc, acc);
+        }
+        sc_montmul(acc, acc, table[(sc_l_minus_2[i / 2] >> (4 * (i & 1))) & 15]);
+    }
+    sc_copy(r, acc);
+}
+
+void mx25519_scalar_reduce512(mx25519_privkey* result, const uint8_t data[64])
+{
+    sc lo, hi, t;
+
+    assert(result != NULL);
+    assert(data != NULL);
+
+    TRACE_PROBE2(scalar__entry, TRACE_SCALAR_REDUCE512, 1);
+    /* x * R = lo * R + hi * R^2 */
+    sc_load(lo, data);
+    sc_load(hi, data + 32);
+    sc_montmul(lo, lo, sc_r2);
+    sc_montmul(hi, hi, sc_r3);
+    sc_add(t, lo, hi);
+    sc_montmul(t, t, sc_one);
+    sc_store(result->data, t);
+    TRACE_PROBE2(scalar__exit, TRACE_SCALAR_REDUCE512, 1);
+}
+
+void mx25519_scalar_mul(mx25519_privkey* result, const mx25519_privkey* a,
+    const mx25519_privkey* b)
+{
+    sc x, y;
+
+    assert(result != NULL);
+    assert(a != NULL);
+    assert(b != NULL);
+
+    TRACE_PROBE2(scalar__entry, TRACE_SCALAR_MUL, 1);
+    sc_load(x, a->data);
+    sc_load(y, b->data);
+    sc_montmul(x, x, sc_r2); /* a * R */
+    sc_montmul(x, y, x);     /* a * b */
+    sc_store(result->data, x);
+    TRACE_PROBE2(scalar__exit, TRACE_SCALAR_MUL, 1);
+}
+
+void mx25519_scalar_invert(mx25519_privkey* result, const mx25519_privkey* a)
+{
+    mx25519_scalar_invert_batch(result, a, 1);
+}
+
+void mx25519_scalar_invert_batch(mx25519_privkey* results,
+    const mx25519_privkey* scalars, size_t count)
+{
+    sc acc[SCALAR_BATCH_CHUNK];
+    sc x, inv, t;
+    uint32_t zero;
+    size_t i, n;
+    const size_t total = count;
+
+    assert(count == 0 || (results != NULL && scalars != NULL));
+
+    TRACE_PROBE2(scalar__entry, TRACE_SCALAR_INVERT, total);
+    while (count > 0) {
+        n = count < SCALAR_BATCH_CHUNK ? count : SCALAR_BATCH_CHUNK;
+
+        /* acc[i] = x[0] * ... * x[i] in the Montgomery domain,
+           zero scalars are replaced with 1 */
+        for (i = 0; i < n; ++i) {
+            sc_load(x, scalars[i].data);
+            sc_montmul(x, x, sc_r2);
+            sc_select(x, x, sc_r1, sc_zero_mask(x));
+            if (i == 0) {
+                sc_copy(acc[0], x);
+            }
+            else {
+                sc_montmul(acc[i], acc[i - 1], x);
+            }
+        }
+
+        sc_pow_inv(inv, acc[n - 1]);
+
+        for (i = n; i-- > 0; ) {
+            sc_load(x, scalars[i].data);
+            sc_montmul(x, x, sc_r2);
+            zero = sc_zero_mask(x);
+            sc_select(x, x, sc_r1, zero);
+            if (i > 0) {
+                sc_montmul(t, inv, acc[i - 1]);
+                sc_montmul(inv, inv, x);
+            }
+            else {
+                sc_copy(t, inv);
+            }
+            sc_montmul(t, t, sc_one);
+            sc_select(t, t, sc_zero, zero);
+            sc_store(results[i].data, t);
+        }
+
+        results += n;
+        scalars += n;
+        count -= n;
+    }
+    TRACE_PROBE2(scalar__exit, TRACE_SCALAR_INVERT, total);
+}
@@ -0,0 +1,187 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+#include "stats.h"
+#include "platform.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#if defined(PLATFORM_AMD64) || defined(PLATFORM_X86)
+#include <x86intrin.h>
+#endif
+#endif
+
+#if !defined(PLATFORM_WIN)
+#include <pthread.h>
+#define STATS_PTHREAD /* blocks of exited threads are reused */
+#endif
+
+/*
+ * Counters only have one writer (the owner thread), so they are updated
+ * with plain atomic loads and stores instead of read-modify-write
+ * instructions.
+ */
+#if defined(_MSC_VER)
+#define counter_load(p) (*(volatile uint64_t*)(p))
+#define counter_store(p, v) (*(volatile uint64_t*)(p) = (v))
+#define block_load(p) (*(void* volatile*)(p))
+#define block_cas(p, e, d) \
+    (_InterlockedCompareExchangePointer((void* volatile*)(p), (d), (e)) == (e))
+#define flag_store(p, v) _InterlockedExchange((volatile long*)(p), (v))
+#define flag_cas(p, e, d) \
+    (_InterlockedCompareExchange((volatile long*)(p), (d), (e)) == (e))
+#else
+#define counter_load(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#define counter_store(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#define block_load(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define block_cas(p, e, d) __atomic_compare_exchange_n((p), &(e), (d), 0, \
+    __ATOMIC_RELEASE, __ATOMIC_RELAXED)
+#define flag_store(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define flag_cas(p, e, d) __atomic_compare_exchange_n((p), &(e), (d), 0, \
+    __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)
+#endif
+
+typedef struct stats_block {
+    struct stats_block* next;
+    long in_use;
+    mx25519_stats stats;
+} stats_block;
+
+#ifdef MX25519_STATS
+static volatile int stats_enabled = 1;
+#else
+static volatile int stats_enabled = 0;
+#endif
+
+/* all blocks ever allocated, never freed */
+static stats_block* stats_blocks = NULL;
+static THREAD_LOCAL stats_block* stats_thread_block = NULL;
+
+#ifdef STATS_PTHREAD
+static pthread_once_t stats_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t stats_key;
+
+static void stats_release_block(void* ptr) {
+    stats_block* block = ptr;
+    flag_store(&block->in_use, 0);
+}
+
+static void stats_create_key(void) {
+    pthread_key_create(&stats_key, &stats_release_block);
+}
+#endif
+
+static stats_block* stats_acquire_block(void) {
+    stats_block* block;
+    stats_block* head;
+
+    /* reuse the block of an exited thread */
+    for (block = block_load(&stats_blocks); block != NULL; block = block->next) {
+        long expected = 0;
+        if (flag_cas(&block->in_use, expected, 1)) {
+            goto acquired;
+        }
+    }
+    block = calloc(1, sizeof(stats_block));
+    if (block == NULL) {
+        return NULL;
+    }
+    block->in_use = 1;
+    do {
+        head = block_load(&stats_blocks);
+        block->next = head;
+    } while (!block_cas(&stats_blocks, head, block));
+
+acquired:
+#ifdef STATS_PTHREAD
+    pthread_once(&stats_key_once, &stats_create_key);
+    pthread_setspecific(stats_key, block);
+#endif
+    return block;
+}
+
+uint64_t mx25519_stats_ticks(void) {
+#if defined(PLATFORM_AMD64) || defined(PLATFORM_X86)
+    return __rdtsc();
+#elif defined(PLATFORM_ARM64) && !defined(_MSC_VER)
+    uint64_t vct;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(vct));
+    return vct;
+#else
+    return clock();
+#endif
+}
+
+static unsigned stats_bucket(uint64_t ticks) {
+    unsigned bucket = 0;
+    while (ticks != 0 && bucket < MX25519_STATS_BUCKETS - 1) {
+        ticks >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+static void counter_add(uint64_t* counter, uint64_t value) {
+    counter_store(counter, counter_load(counter) + value);
+}
+
+void mx25519_stats_record(mx25519_type type, mx25519_op op, uint64_t ticks,
+    size_t count)
+{
+    stats_block* block = stats_thread_block;
+
+    if (count == 0 || type < 0 || type >= MX25519_STATS_TYPES) {
+        return;
+    }
+    if (block == NULL) {
+        block = stats_acquire_block();
+        if (block == NULL) {
+            return;
+        }
+        stats_thread_block = block;
+    }
+    counter_add(&block->stats.count[type][op], count);
+    counter_add(&block->stats.ticks[type], ticks);
+    counter_add(&block->stats.histogram[type][stats_bucket(ticks / count)],
+        count);
+}
+
+int mx25519_stats_is_enabled(void)
+{
+    return stats_enabled;
+}
+
+void mx25519_stats_enable(int enable)
+{
+    stats_enabled = enable != 0;
+}
+
+void mx25519_stats_snapshot(mx25519_stats* stats)
+{
+    stats_block* block;
+    int t, i;
+
+    memset(stats, 0, sizeof(*stats));
+    for (block = block_load(&stats_blocks); block != NULL; block = block->next) {
+        for (t = 0; t < MX25519_STATS_TYPES; ++t) {
+            for (i = 0; i < MX25519_OP_COUNT; ++i) {
+                stats->count[t][i] += counter_load(&block->stats.count[t][i]);
+            }
+            stats->ticks[t] += counter_load(&block->stats.ticks[t]);
+            for (i = 0; i < MX25519_STATS_BUCKETS; ++i) {
+                stats->histogram[t][i] +=
+                    counter_load(&block->stats.histogram[t][i]);
+            }
+        }
+    }
+}
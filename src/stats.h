@@ -0,0 +1,35 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <mx25519.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+int mx25519_stats_is_enabled(void);
+
+uint64_t mx25519_stats_ticks(void);
+
+void mx25519_stats_record(mx25519_type type, mx25519_op op, uint64_t ticks,
+    size_t count);
+
+/* returns the start time or 0 if statistics are disabled */
+static inline uint64_t stats_begin(void) {
+    return mx25519_stats_is_enabled() ? mx25519_stats_ticks() : 0;
+}
+
+static inline void stats_end(uint64_t start, mx25519_type type,
+    mx25519_op op, size_t count)
+{
+    if (start != 0) {
+        mx25519_stats_record(type, op, mx25519_stats_ticks() - start, count);
+    }
+}
+
+#endif
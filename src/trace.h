@@ -0,0 +1,51 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+/*
+ * USDT probes (provider "mx25519"). Each probe is a single nop until a
+ * tracer such as bpftrace or perf attaches to it, e.g.:
+ *
+ *     bpftrace -e 'usdt:./libmx25519.so:mx25519:scmul__entry { ... }'
+ *
+ * scmul__entry(type, op), scmul__exit(type, op):
+ *     a public scalar multiplication, op is a mx25519_op value
+ * batch__entry(type, count), batch__exit(type, count):
+ *     mx25519_scmul_key_batch
+ * ladder__exit(type, count):
+ *     the ladders of a batch chunk are done, normalization follows
+ * invert__entry(count), invert__exit(count):
+ *     the shared field inversion for `count` points
+ * resumable__entry(stage, remaining), resumable__exit(stage, remaining):
+ *     mx25519_scmul_begin/step/finish, stage is a TRACE_RESUMABLE_* value
+ *     and remaining is the number of ladder steps left
+ * scalar__entry(op, count), scalar__exit(op, count):
+ *     mx25519_scalar_*, op is a TRACE_SCALAR_* value and count is the
+ *     number of scalars
+ * cache__hit(handle), cache__miss(handle):
+ *     mx25519_cache_scmul_key, a miss is followed by scmul__entry
+ */
+
+#define TRACE_RESUMABLE_BEGIN 0
+#define TRACE_RESUMABLE_STEP 1
+#define TRACE_RESUMABLE_FINISH 2
+
+#define TRACE_SCALAR_REDUCE512 0
+#define TRACE_SCALAR_MUL 1
+#define TRACE_SCALAR_INVERT 2
+
+#ifdef MX25519_USDT
+#include <sys/sdt.h>
+#define TRACE_PROBE1(name, a) DTRACE_PROBE1(mx25519, name, a)
+#define TRACE_PROBE2(name, a, b) DTRACE_PROBE2(mx25519, name, a, b)
+#else
+#define TRACE_PROBE1(name, a) do { (void)(a); } while (0)
+#define TRACE_PROBE2(name, a, b) do { (void)(a); (void)(b); } while (0)
+#endif
+
+#endif
@@ -12,6 +12,18 @@
 #include <math.h>
 
 #include <mx25519.h>
+#ifdef MX25519_CACHE
+#include <mx25519_cache.h>
+#endif
+
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(MX25519_FORCE_IMPL_PORTABLE)
+#include "amd64/scalarmult.h"
+#define HAVE_AMD64_KERNELS
+#endif
+
+#ifdef PLATFORM_UINT128
+#include "portable/fe64.h"
+#endif
 
 #ifdef _DEBUG
 #define BENCH_LOOPS 10
@@ -19,8 +31,67 @@
 #define BENCH_LOOPS 100000
 #endif
 
+#define BENCH_BATCH 64
+
 typedef double bench_func();
 
+/*
+ * In the mixed-workload mode (--mixed), about 80 KB of unrelated code runs
+ * before each operation, which evicts the kernel from the L1 instruction
+ * cache and the uop cache, like a server that handles a request between
+ * two key exchanges. The time spent in the unrelated code is excluded, so
+ * the difference to the default mode is the cost of the cold caches.
+ */
+static bool mixed = false;
+
+typedef uint64_t pollute_func(uint64_t x);
+
+#define POLLUTE_FUNC(n)                                 \
+    static uint64_t pollute_##n(uint64_t x) {           \
+        x ^= x >> (n % 29 + 3);                         \
+        x *= 0x9e3779b97f4a7c15ull + 2 * n;             \
+        x ^= x >> 31;                                   \
+        x += (uint64_t)n << (n % 23 + 7);               \
+        x *= 0xbf58476d1ce4e5b9ull ^ n;                 \
+        return x ^ (x >> (n % 17 + 11));                \
+    }
+#define POLLUTE_PTR(n) &pollute_##n,
+
+#define D10(m, p) m(p##0) m(p##1) m(p##2) m(p##3) m(p##4) \
+    m(p##5) m(p##6) m(p##7) m(p##8) m(p##9)
+#define D100(m, p) D10(m, p##0) D10(m, p##1) D10(m, p##2) D10(m, p##3) \
+    D10(m, p##4) D10(m, p##5) D10(m, p##6) D10(m, p##7) D10(m, p##8) \
+    D10(m, p##9)
+#define D1000(m, p) D100(m, p##0) D100(m, p##1) D100(m, p##2) \
+    D100(m, p##3) D100(m, p##4) D100(m, p##5) D100(m, p##6) D100(m, p##7) \
+    D100(m, p##8) D100(m, p##9)
+
+D1000(POLLUTE_FUNC, 1)
+
+static pollute_func* const pollute_table[] = {
+    D1000(POLLUTE_PTR, 1)
+};
+
+static volatile uint64_t pollute_sink;
+
+static void other_work(void) {
+    uint64_t x = pollute_sink;
+    for (size_t i = 0; i < sizeof(pollute_table) / sizeof(pollute_table[0]); ++i) {
+        x = pollute_table[i](x);
+    }
+    pollute_sink = x;
+}
+
+/* runs other_work without counting its cycles */
+#define MIXED_WORK(elapsed, start)                      \
+    do {                                                \
+        if (mixed) {                                    \
+            elapsed += mx25519_cpu_cycles() - start;    \
+            other_work();                               \
+            start = mx25519_cpu_cycles();               \
+        }                                               \
+    } while (0)
+
 static const mx25519_privkey test_key = { {
     102, 66, 236, 240, 6, 149, 92, 7, 43, 107, 163, 255, 64, 145, 5, 203,
     230, 54, 147, 234, 197, 5, 215, 214, 124, 189, 226, 219, 235, 71, 20, 254 } };
@@ -37,6 +108,7 @@ double bench_impl(mx25519_type type) {
     uint64_t elapsed = 0;
     uint64_t start = mx25519_cpu_cycles();
     for (uint32_t i = 0; i < BENCH_LOOPS; ++i) {
+        MIXED_WORK(elapsed, start);
         mx25519_scmul_key(impl, &result, &test_key, &result);
     }
     uint64_t end = mx25519_cpu_cycles();
@@ -61,6 +133,297 @@ double bench_amd64x() {
     return bench_impl(MX25519_TYPE_AMD64X);
 }
 
+double bench_arm64_mul64() {
+    return bench_impl(MX25519_TYPE_ARM64_MUL64);
+}
+
+double bench_amd64_mulx() {
+    return bench_impl(MX25519_TYPE_AMD64_MULX);
+}
+
+double bench_amd64x_compact() {
+    return bench_impl(MX25519_TYPE_AMD64X_COMPACT);
+}
+
+double bench_arm64_sve2() {
+    return bench_impl(MX25519_TYPE_ARM64_SVE2);
+}
+
+/* key generation, which uses the base point kernels */
+double bench_base_impl(mx25519_type type) {
+    const mx25519_impl* impl = mx25519_select_impl(type);
+
+    if (impl == NULL) {
+        return NAN;
+    }
+
+    mx25519_pubkey result;
+
+    uint64_t elapsed = 0;
+    uint64_t start = mx25519_cpu_cycles();
+    for (uint32_t i = 0; i < BENCH_LOOPS; ++i) {
+        MIXED_WORK(elapsed, start);
+        mx25519_scmul_base(impl, &result, &test_key);
+    }
+    uint64_t end = mx25519_cpu_cycles();
+    elapsed += (end - start);
+
+    return elapsed / (double)BENCH_LOOPS;
+}
+
+double bench_base_portable() {
+    return bench_base_impl(MX25519_TYPE_PORTABLE);
+}
+
+double bench_base_arm64() {
+    return bench_base_impl(MX25519_TYPE_ARM64);
+}
+
+double bench_base_amd64() {
+    return bench_base_impl(MX25519_TYPE_AMD64);
+}
+
+double bench_base_amd64x() {
+    return bench_base_impl(MX25519_TYPE_AMD64X);
+}
+
+double bench_base_arm64_mul64() {
+    return bench_base_impl(MX25519_TYPE_ARM64_MUL64);
+}
+
+double bench_base_amd64_mulx() {
+    return bench_base_impl(MX25519_TYPE_AMD64_MULX);
+}
+
+double bench_base_amd64x_compact() {
+    return bench_base_impl(MX25519_TYPE_AMD64X_COMPACT);
+}
+
+double bench_base_arm64_sve2() {
+    return bench_base_impl(MX25519_TYPE_ARM64_SVE2);
+}
+
+typedef void kernel_func(uint8_t* q, const uint8_t* n, const uint8_t* p,
+    uint8_t clamp_lo, uint8_t clamp_hi);
+
+/* calls a kernel directly, bypassing the runtime selection */
+double bench_kernel(mx25519_type type, kernel_func* kernel) {
+    if (mx25519_select_impl(type) == NULL) {
+        return NAN;
+    }
+
+    mx25519_pubkey result = { { 9 } };
+
+    uint64_t elapsed = 0;
+    uint64_t start = mx25519_cpu_cycles();
+    for (uint32_t i = 0; i < BENCH_LOOPS; ++i) {
+        MIXED_WORK(elapsed, start);
+        kernel(result.data, test_key.data, result.data, 248, 64);
+    }
+    uint64_t end = mx25519_cpu_cycles();
+    elapsed += (end - start);
+
+    return elapsed / (double)BENCH_LOOPS;
+}
+
+double bench_amd64x_gpr() {
+#ifdef HAVE_AMD64_KERNELS
+    return bench_kernel(MX25519_TYPE_AMD64X, &mx25519_scalarmult_amd64x_gpr);
+#else
+    return NAN;
+#endif
+}
+
+double bench_batch_impl(mx25519_type type) {
+    const mx25519_impl* impl = mx25519_select_impl(type);
+
+    if (impl == NULL) {
+        return NAN;
+    }
+
+    mx25519_privkey keys[BENCH_BATCH];
+    mx25519_pubkey points[BENCH_BATCH];
+    mx25519_pubkey results[BENCH_BATCH];
+
+    for (int i = 0; i < BENCH_BATCH; ++i) {
+        keys[i] = test_key;
+        keys[i].data[0] = i;
+        memset(&points[i], 0, sizeof(points[i]));
+        points[i].data[0] = 9;
+    }
+
+    uint64_t elapsed = 0;
+    uint64_t start = mx25519_cpu_cycles();
+    for (uint32_t i = 0; i < BENCH_LOOPS / BENCH_BATCH; ++i) {
+        MIXED_WORK(elapsed, start);
+        mx25519_scmul_key_batch(impl, results, keys, points, BENCH_BATCH);
+        memcpy(points, results, sizeof(points));
+    }
+    uint64_t end = mx25519_cpu_cycles();
+    elapsed += (end - start);
+
+    return elapsed / (double)(BENCH_LOOPS / BENCH_BATCH * BENCH_BATCH);
+}
+
+double bench_batch_portable() {
+    return bench_batch_impl(MX25519_TYPE_PORTABLE);
+}
+
+double bench_batch_arm64() {
+    return bench_batch_impl(MX25519_TYPE_ARM64);
+}
+
+double bench_batch_amd64() {
+    return bench_batch_impl(MX25519_TYPE_AMD64);
+}
+
+double bench_batch_amd64x() {
+    return bench_batch_impl(MX25519_TYPE_AMD64X);
+}
+
+double bench_batch_arm64_mul64() {
+    return bench_batch_impl(MX25519_TYPE_ARM64_MUL64);
+}
+
+double bench_batch_amd64_mulx() {
+    return bench_batch_impl(MX25519_TYPE_AMD64_MULX);
+}
+
+double bench_batch_amd64x_compact() {
+    return bench_batch_impl(MX25519_TYPE_AMD64X_COMPACT);
+}
+
+double bench_batch_arm64_sve2() {
+    return bench_batch_impl(MX25519_TYPE_ARM64_SVE2);
+}
+
+#ifdef PLATFORM_UINT128
+/*
+ * Fermat inversion z^(p-2) with the addition chain of ref10 (254 squarings
+ * and 11 multiplications), as done by the ARM64 assembly before it switched
+ * to fe64_invert. Both use the same 64-bit limbs, so the difference is
+ * the cost of the algorithm.
+ */
+static void fe64_invert_fermat(fe64 out, const fe64 z) {
+    fe64 t0, t1, t2, t3;
+    int i;
+
+    fe64_sq(t0, z);
+    fe64_sq(t1, t0);
+    fe64_sq(t1, t1);
+    fe64_mul(t1, z, t1);
+    fe64_mul(t0, t0, t1);
+    fe64_sq(t2, t0);
+    fe64_mul(t1, t1, t2);
+    fe64_sq(t2, t1);
+    for (i = 1; i < 5; ++i) fe64_sq(t2, t2);
+    fe64_mul(t1, t2, t1);
+    fe64_sq(t2, t1);
+    for (i = 1; i < 10; ++i) fe64_sq(t2, t2);
+    fe64_mul(t2, t2, t1);
+    fe64_sq(t3, t2);
+    for (i = 1; i < 20; ++i) fe64_sq(t3, t3);
+    fe64_mul(t2, t3, t2);
+    for (i = 0; i < 10; ++i) fe64_sq(t2, t2);
+    fe64_mul(t1, t2, t1);
+    fe64_sq(t2, t1);
+    for (i = 1; i < 50; ++i) fe64_sq(t2, t2);
+    fe64_mul(t2, t2, t1);
+    fe64_sq(t3, t2);
+    for (i = 1; i < 100; ++i) fe64_sq(t3, t3);
+    fe64_mul(t2, t3, t2);
+    for (i = 0; i < 50; ++i) fe64_sq(t2, t2);
+    fe64_mul(t1, t2, t1);
+    for (i = 0; i < 5; ++i) fe64_sq(t1, t1);
+    fe64_mul(out, t1, t0);
+}
+
+typedef void invert_func(fe64 out, const fe64 z);
+
+double bench_invert(invert_func* invert) {
+    uint8_t check[2][32];
+    fe64 z;
+
+    /* both inversions must agree */
+    fe64_frombytes(z, test_key.data);
+    fe64_invert(z, z);
+    fe64_tobytes(check[0], z);
+    fe64_frombytes(z, test_key.data);
+    fe64_invert_fermat(z, z);
+    fe64_tobytes(check[1], z);
+    if (memcmp(check[0], check[1], 32) != 0) {
+        return NAN;
+    }
+
+    uint64_t elapsed = 0;
+    uint64_t start = mx25519_cpu_cycles();
+    for (uint32_t i = 0; i < BENCH_LOOPS; ++i) {
+        MIXED_WORK(elapsed, start);
+        invert(z, z);
+    }
+    uint64_t end = mx25519_cpu_cycles();
+    elapsed += (end - start);
+
+    return elapsed / (double)BENCH_LOOPS;
+}
+#endif
+
+double bench_invert_safegcd() {
+#ifdef PLATFORM_UINT128
+    return bench_invert(&fe64_invert);
+#else
+    return NAN;
+#endif
+}
+
+double bench_invert_fermat() {
+#ifdef PLATFORM_UINT128
+    return bench_invert(&fe64_invert_fermat);
+#else
+    return NAN;
+#endif
+}
+
+#define BENCH_CACHE_PEERS 1024
+
+/* repeated handshakes with the same peers, all of which are cached */
+double bench_cache_hit() {
+#ifdef MX25519_CACHE
+    mx25519_cache_config config = { 0 };
+    config.impl = mx25519_select_impl(MX25519_TYPE_AUTO);
+    config.allow_unlocked = 1;
+    mx25519_cache* cache = mx25519_cache_create(&config);
+    if (cache == NULL) {
+        return NAN;
+    }
+    static mx25519_pubkey peers[BENCH_CACHE_PEERS];
+    mx25519_pubkey result;
+    int handle = mx25519_cache_add_key(cache, &test_key);
+    for (int i = 0; i < BENCH_CACHE_PEERS; ++i) {
+        memset(&peers[i], 0, sizeof(peers[i]));
+        peers[i].data[0] = 9;
+        peers[i].data[1] = i & 0xff;
+        peers[i].data[2] = i >> 8;
+        mx25519_cache_scmul_key(cache, &result, handle, &peers[i]);
+    }
+
+    uint64_t elapsed = 0;
+    uint64_t start = mx25519_cpu_cycles();
+    for (uint32_t i = 0; i < BENCH_LOOPS; ++i) {
+        MIXED_WORK(elapsed, start);
+        mx25519_cache_scmul_key(cache, &result, handle,
+            &peers[i % BENCH_CACHE_PEERS]);
+    }
+    uint64_t end = mx25519_cpu_cycles();
+    elapsed += (end - start);
+
+    mx25519_cache_destroy(cache);
+    return elapsed / (double)BENCH_LOOPS;
+#else
+    return NAN;
+#endif
+}
+
 static void run_bench(const char* name, bench_func* func) {
     printf("    %-40s ... ", name);
     double cycles = func();
@@ -76,6 +439,19 @@ static void run_bench(const char* name, bench_func* func) {
 
 int main(int argc, const char* argv[]) {
 
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--mixed") == 0) {
+            mixed = true;
+        }
+        else {
+            printf("Usage: %s [--mixed]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (mixed) {
+        printf("Mixed workload: instruction caches are cold for each operation\n");
+    }
+
     double wall_start = mx25519_wall_clock();
     uint64_t cpu_start = mx25519_cpu_cycles();
 
@@ -83,6 +459,30 @@ int main(int argc, const char* argv[]) {
     RUN_BENCH(bench_arm64);
     RUN_BENCH(bench_amd64);
     RUN_BENCH(bench_amd64x);
+    RUN_BENCH(bench_amd64x_gpr);
+    RUN_BENCH(bench_arm64_mul64);
+    RUN_BENCH(bench_amd64_mulx);
+    RUN_BENCH(bench_amd64x_compact);
+    RUN_BENCH(bench_arm64_sve2);
+    RUN_BENCH(bench_base_portable);
+    RUN_BENCH(bench_base_arm64);
+    RUN_BENCH(bench_base_amd64);
+    RUN_BENCH(bench_base_amd64x);
+    RUN_BENCH(bench_base_arm64_mul64);
+    RUN_BENCH(bench_base_amd64_mulx);
+    RUN_BENCH(bench_base_amd64x_compact);
+    RUN_BENCH(bench_base_arm64_sve2);
+    RUN_BENCH(bench_batch_portable);
+    RUN_BENCH(bench_batch_arm64);
+    RUN_BENCH(bench_batch_amd64);
+    RUN_BENCH(bench_batch_amd64x);
+    RUN_BENCH(bench_batch_arm64_mul64);
+    RUN_BENCH(bench_batch_amd64_mulx);
+    RUN_BENCH(bench_batch_amd64x_compact);
+    RUN_BENCH(bench_batch_arm64_sve2);
+    RUN_BENCH(bench_invert_safegcd);
+    RUN_BENCH(bench_invert_fermat);
+    RUN_BENCH(bench_cache_hit);
 
     double wall_end = mx25519_wall_clock();
     uint64_t cpu_end = mx25519_cpu_cycles();
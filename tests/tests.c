@@ -9,9 +9,33 @@
 #endif
 
 #include <mx25519.h>
+#ifdef MX25519_ASYNC
+#include <mx25519_async.h>
+#include <poll.h>
+#endif
+#ifdef MX25519_CACHE
+#include <mx25519_cache.h>
+#include <pthread.h>
+#endif
+
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(MX25519_FORCE_IMPL_PORTABLE)
+#include "amd64/scalarmult.h"
+#define HAVE_AMD64_KERNELS
+#endif
+
+/* the portable kernel is built unless another implementation is forced */
+#if !defined(MX25519_FORCE_IMPL_ARM64) && !defined(MX25519_FORCE_IMPL_AMD64) \
+    && !defined(MX25519_FORCE_IMPL_AMD64X) && !defined(MX25519_FORCE_IMPL_ARM64_MUL64) \
+    && !defined(MX25519_FORCE_IMPL_AMD64_MULX) && !defined(MX25519_FORCE_IMPL_AMD64X_COMPACT) \
+    && !defined(MX25519_FORCE_IMPL_ARM64_SVE2)
+#include "portable/scalarmult.h"
+#include "portable/fe.h"
+#define HAVE_PORTABLE_LADDER
+#endif
 
 #include <assert.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -51,6 +75,11 @@ static const char rfc7748_bob_priv[] = "5dab087e624a8a4b79e17f8b83800ee66f3bb129
 static const char rfc7748_bob_pub[] = "de9edb7d7b7dc1b4d35b61c2ece435373f8343c85b78674dadfc7e146f882b4f";
 static const char rfc7748_shared[] = "4a5d9d5ba4ce2de1728e3bf480350f25e07e21c947d19e3376f09b3c1e161742";
 
+/* v-coordinates of the DH keys */
+static const char test_alice_pub_v[] = "92f4ff302c8b083a4bc901299aebdf4d26a5d5e00bdb493acc10a0b228db3657";
+static const char test_bob_pub_v[] = "906d01bbe36bf54a01c70f07c21f2d71d5e9552b1a0b673f2ddd61fdf8739902";
+static const char test_shared_v[] = "a4800d4ace6d86f461edc325e50de38b7a754569586d29da41584380528f040e";
+
 static const mx25519_impl* impl;
 
 static inline void output_hex(const uint8_t* data, int length) {
@@ -97,6 +126,131 @@ static bool check_scmul(const char* key_hex, const char* pt_hex, const char* res
     return check_scmul_unclamped(key_hex, pt_hex, res_hex, MX25519_UNCLAMP_NONE);
 }
 
+static uint64_t rng_state = 0x9e3779b97f4a7c15;
+
+static void random_bytes(uint8_t* out, int length) {
+    for (int i = 0; i < length; ++i) {
+        /* xorshift64 */
+        rng_state ^= rng_state << 13;
+        rng_state ^= rng_state >> 7;
+        rng_state ^= rng_state << 17;
+        out[i] = (uint8_t)rng_state;
+    }
+}
+
+#define DIFF_TEST_ROUNDS 256
+
+/* compares the current implementation with the portable implementation */
+static void check_vs_portable() {
+    assert(impl != NULL);
+    const mx25519_impl* portable = mx25519_select_impl(MX25519_TYPE_PORTABLE);
+    if (portable == NULL) {
+        /* single implementation build */
+        return;
+    }
+    for (int i = 0; i < DIFF_TEST_ROUNDS; ++i) {
+        mx25519_privkey key;
+        mx25519_pubkey pt, res1, res2;
+        random_bytes(key.data, sizeof(key.data));
+        random_bytes(pt.data, sizeof(pt.data));
+        if (i < 2) {
+            /* points 0 and 1 */
+            memset(pt.data, 0, sizeof(pt.data));
+            pt.data[0] = i;
+        }
+        mx25519_scmul_key(portable, &res1, &key, &pt);
+        mx25519_scmul_key(impl, &res2, &key, &pt);
+        assert(memcmp(&res1, &res2, sizeof(res1)) == 0);
+        mx25519_scmul_key_unclamped(portable, &res1, &key, &pt, MX25519_UNCLAMP_ALL);
+        mx25519_scmul_key_unclamped(impl, &res2, &key, &pt, MX25519_UNCLAMP_ALL);
+        assert(memcmp(&res1, &res2, sizeof(res1)) == 0);
+    }
+}
+
+#define BATCH_TEST_SIZE 100
+
+/* compares batch results with single scalar multiplications */
+static void check_batch() {
+    assert(impl != NULL);
+    mx25519_privkey keys[BATCH_TEST_SIZE];
+    mx25519_pubkey pts[BATCH_TEST_SIZE], res[BATCH_TEST_SIZE];
+    random_bytes((uint8_t*)keys, sizeof(keys));
+    random_bytes((uint8_t*)pts, sizeof(pts));
+    /* points of small order produce 0 */
+    memset(&pts[3], 0, sizeof(pts[3]));
+    memset(&pts[40], 0, sizeof(pts[40]));
+    pts[40].data[0] = 1;
+    mx25519_scmul_key_batch(impl, res, keys, pts, BATCH_TEST_SIZE);
+    for (int i = 0; i < BATCH_TEST_SIZE; ++i) {
+        mx25519_pubkey res1;
+        mx25519_scmul_key(impl, &res1, &keys[i], &pts[i]);
+        assert(memcmp(&res1, &res[i], sizeof(res1)) == 0);
+    }
+}
+
+/* checks projective results against mx25519_scmul_key */
+static void check_projective() {
+    assert(impl != NULL);
+    mx25519_privkey keys[BATCH_TEST_SIZE];
+    mx25519_pubkey pts[BATCH_TEST_SIZE], res[BATCH_TEST_SIZE];
+    mx25519_projective proj[BATCH_TEST_SIZE];
+    random_bytes((uint8_t*)keys, sizeof(keys));
+    random_bytes((uint8_t*)pts, sizeof(pts));
+    memset(&pts[7], 0, sizeof(pts[7]));
+    for (int i = 0; i < BATCH_TEST_SIZE; ++i) {
+        mx25519_pubkey res1;
+        mx25519_scmul_key_projective(impl, &proj[i], &keys[i], &pts[i]);
+        mx25519_scmul_key(impl, &res1, &keys[i], &pts[i]);
+        assert(mx25519_projective_equals(&res1, &proj[i]) == 1);
+        res1.data[i % 32] ^= 1 << (i % 8);
+        assert(mx25519_projective_equals(&res1, &proj[i]) == 0);
+        res1.data[i % 32] ^= 1 << (i % 8);
+        /* non-canonical encodings are not equal */
+        res1.data[31] ^= 0x80;
+        assert(mx25519_projective_equals(&res1, &proj[i]) == 0);
+    }
+    mx25519_projective_normalize_batch(res, proj, BATCH_TEST_SIZE);
+    for (int i = 0; i < BATCH_TEST_SIZE; ++i) {
+        mx25519_pubkey res1;
+        mx25519_scmul_key(impl, &res1, &keys[i], &pts[i]);
+        assert(memcmp(&res1, &res[i], sizeof(res1)) == 0);
+    }
+}
+
+/* checks mx25519_scmul_base_and_key against separate calls */
+static void check_base() {
+    assert(impl != NULL);
+    const mx25519_pubkey base = { { 9 } };
+    for (int i = 0; i < DIFF_TEST_ROUNDS; ++i) {
+        mx25519_privkey key;
+        mx25519_pubkey pub, pub1;
+        mx25519_unclamp_flags flags = (mx25519_unclamp_flags)(i & 3);
+        random_bytes(key.data, sizeof(key.data));
+        mx25519_scmul_base_unclamped(impl, &pub, &key, flags);
+        mx25519_scmul_key_unclamped(impl, &pub1, &key, &base, flags);
+        assert(memcmp(&pub, &pub1, sizeof(pub)) == 0);
+    }
+}
+
+static void check_base_and_key() {
+    assert(impl != NULL);
+    for (int i = 0; i < DIFF_TEST_ROUNDS; ++i) {
+        mx25519_privkey key;
+        mx25519_pubkey pt, pub, shared, pub1, shared1;
+        random_bytes(key.data, sizeof(key.data));
+        random_bytes(pt.data, sizeof(pt.data));
+        if (i == 0) {
+            /* point of small order */
+            memset(pt.data, 0, sizeof(pt.data));
+        }
+        mx25519_scmul_base_and_key(impl, &pub, &shared, &key, &pt);
+        mx25519_scmul_base(impl, &pub1, &key);
+        mx25519_scmul_key(impl, &shared1, &key, &pt);
+        assert(memcmp(&pub, &pub1, sizeof(pub)) == 0);
+        assert(memcmp(&shared, &shared1, sizeof(shared)) == 0);
+    }
+}
+
 static void check_dh() {
     assert(impl != NULL);
     mx25519_privkey alice_priv, bob_priv;
@@ -114,46 +268,592 @@ static void check_dh() {
     assert(equals_hex(&bob_shared, rfc7748_shared));
 }
 
+static void check_full() {
+    assert(impl != NULL);
+    mx25519_privkey alice_priv, bob_priv;
+    load_key(alice_priv, rfc7748_alice_priv);
+    load_key(bob_priv, rfc7748_bob_priv);
+    mx25519_point alice_pub, bob_pub;
+    mx25519_scmul_base_full(impl, &alice_pub, &alice_priv);
+    assert(equals_hex(alice_pub.u, rfc7748_alice_pub));
+    assert(equals_hex(alice_pub.v, test_alice_pub_v));
+    mx25519_scmul_base_full(impl, &bob_pub, &bob_priv);
+    assert(equals_hex(bob_pub.u, rfc7748_bob_pub));
+    assert(equals_hex(bob_pub.v, test_bob_pub_v));
+    mx25519_point alice_shared, bob_shared;
+    mx25519_scmul_key_full(impl, &alice_shared, &alice_priv, &bob_pub);
+    assert(equals_hex(alice_shared.u, rfc7748_shared));
+    assert(equals_hex(alice_shared.v, test_shared_v));
+    mx25519_scmul_key_full(impl, &bob_shared, &bob_priv, &alice_pub);
+    assert(equals_hex(bob_shared.u, rfc7748_shared));
+    assert(equals_hex(bob_shared.v, test_shared_v));
+}
+
+#ifdef MX25519_ASYNC
+#define ASYNC_TEST_SIZE 1000
+
+static mx25519_privkey async_keys[ASYNC_TEST_SIZE];
+static mx25519_pubkey async_pts[ASYNC_TEST_SIZE];
+static mx25519_pubkey async_res[ASYNC_TEST_SIZE];
+
+static void async_callback(void* user_data, const mx25519_pubkey* result) {
+    async_res[(mx25519_pubkey*)user_data - async_pts] = *result;
+}
+
+static void check_async_results() {
+    for (int i = 0; i < ASYNC_TEST_SIZE; ++i) {
+        mx25519_pubkey res1;
+        mx25519_scmul_key(impl, &res1, &async_keys[i], &async_pts[i]);
+        assert(memcmp(&res1, &async_res[i], sizeof(res1)) == 0);
+    }
+}
+#endif
+
+static bool test_async_callback() {
+#ifdef MX25519_ASYNC
+    impl = mx25519_select_impl(MX25519_TYPE_AUTO);
+    assert(impl != NULL);
+    mx25519_async_config config = { 0 };
+    config.impl = impl;
+    config.queue_size = ASYNC_TEST_SIZE;
+    config.threads = 2;
+    config.max_batch = 16;
+    config.deadline_us = 100;
+    mx25519_async* ctx = mx25519_async_create(&config);
+    assert(ctx != NULL);
+    assert(mx25519_async_fd(ctx) == -1);
+    random_bytes((uint8_t*)async_keys, sizeof(async_keys));
+    random_bytes((uint8_t*)async_pts, sizeof(async_pts));
+    memset(async_res, 0, sizeof(async_res));
+    for (int i = 0; i < ASYNC_TEST_SIZE; ++i) {
+        int res = mx25519_async_submit(ctx, &async_keys[i], &async_pts[i],
+            &async_callback, &async_pts[i]);
+        assert(res == 0);
+    }
+    /* completes all requests */
+    mx25519_async_destroy(ctx);
+    check_async_results();
+    return true;
+#else
+    return false;
+#endif
+}
+
+static bool test_async_ring() {
+#ifdef MX25519_ASYNC
+    impl = mx25519_select_impl(MX25519_TYPE_AUTO);
+    assert(impl != NULL);
+    mx25519_async_config config = { 0 };
+    config.impl = impl;
+    config.queue_size = 64;
+    config.threads = 3;
+    config.max_batch = 8;
+    config.deadline_us = 50;
+    config.completion_ring = 1;
+    mx25519_async* ctx = mx25519_async_create(&config);
+    assert(ctx != NULL);
+    struct pollfd pfd = { .fd = mx25519_async_fd(ctx), .events = POLLIN };
+    assert(pfd.fd >= 0);
+    random_bytes((uint8_t*)async_keys, sizeof(async_keys));
+    random_bytes((uint8_t*)async_pts, sizeof(async_pts));
+    memset(async_res, 0, sizeof(async_res));
+    int submitted = 0, completed = 0;
+    while (completed < ASYNC_TEST_SIZE) {
+        while (submitted < ASYNC_TEST_SIZE
+            && mx25519_async_submit(ctx, &async_keys[submitted],
+                &async_pts[submitted], NULL, &async_pts[submitted]) == 0) {
+            ++submitted;
+        }
+        int res = poll(&pfd, 1, 1000);
+        assert(res == 1);
+        mx25519_async_completion done[16];
+        size_t count;
+        while ((count = mx25519_async_poll(ctx, done, 16)) > 0) {
+            for (size_t i = 0; i < count; ++i) {
+                async_callback(done[i].user_data, &done[i].result);
+            }
+            completed += count;
+        }
+    }
+    assert(submitted == ASYNC_TEST_SIZE);
+    mx25519_async_destroy(ctx);
+    check_async_results();
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef MX25519_CACHE
+#define CACHE_TEST_PEERS 64
+#define CACHE_TEST_THREADS 4
+
+static mx25519_privkey cache_keys[2];
+static mx25519_pubkey cache_peers[CACHE_TEST_PEERS];
+
+/* checks a cached result against mx25519_scmul_key */
+static int check_cache(mx25519_cache* cache, int handle, int key, int peer) {
+    mx25519_pubkey res1, res2;
+    int hit = mx25519_cache_scmul_key(cache, &res1, handle, &cache_peers[peer]);
+    assert(hit >= 0);
+    mx25519_scmul_key(impl, &res2, &cache_keys[key], &cache_peers[peer]);
+    assert(memcmp(&res1, &res2, sizeof(res1)) == 0);
+    return hit;
+}
+
+typedef struct cache_thread_arg {
+    mx25519_cache* cache;
+    int handles[2];
+    unsigned seed;
+} cache_thread_arg;
+
+static void* cache_thread(void* ptr) {
+    cache_thread_arg* arg = ptr;
+    for (int i = 0; i < 200; ++i) {
+        arg->seed = arg->seed * 1103515245 + 12345;
+        int key = (arg->seed >> 8) & 1;
+        int peer = (arg->seed >> 16) % CACHE_TEST_PEERS;
+        check_cache(arg->cache, arg->handles[key], key, peer);
+        if (i % 50 == 49) {
+            mx25519_cache_invalidate(arg->cache, &cache_peers[peer]);
+        }
+    }
+    return NULL;
+}
+#endif
+
+static bool test_cache() {
+#ifdef MX25519_CACHE
+    impl = mx25519_select_impl(MX25519_TYPE_AUTO);
+    assert(impl != NULL);
+    random_bytes((uint8_t*)cache_keys, sizeof(cache_keys));
+    random_bytes((uint8_t*)cache_peers, sizeof(cache_peers));
+    mx25519_cache_config config = { 0 };
+    config.impl = impl;
+    config.capacity = 4;
+    config.shards = 1;
+    config.max_keys = 2;
+    config.allow_unlocked = 1;
+    mx25519_cache* cache = mx25519_cache_create(&config);
+    assert(cache != NULL);
+    int h0 = mx25519_cache_add_key(cache, &cache_keys[0]);
+    int h1 = mx25519_cache_add_key(cache, &cache_keys[1]);
+    assert(h0 >= 0 && h1 >= 0 && h0 != h1);
+    assert(mx25519_cache_add_key(cache, &cache_keys[0]) == -1);
+    /* the same peer with two local keys */
+    assert(check_cache(cache, h0, 0, 0) == 0);
+    assert(check_cache(cache, h0, 0, 0) == 1);
+    assert(check_cache(cache, h1, 1, 0) == 0);
+    assert(check_cache(cache, h1, 1, 0) == 1);
+    /* least recently used entries are evicted */
+    assert(check_cache(cache, h0, 0, 1) == 0);
+    assert(check_cache(cache, h0, 0, 2) == 0);
+    assert(check_cache(cache, h0, 0, 0) == 1);
+    assert(check_cache(cache, h0, 0, 3) == 0);
+    assert(check_cache(cache, h1, 1, 0) == 0);
+    assert(check_cache(cache, h0, 0, 0) == 1);
+    /* invalidation */
+    assert(mx25519_cache_invalidate(cache, &cache_peers[0]) == 2);
+    assert(mx25519_cache_invalidate(cache, &cache_peers[0]) == 0);
+    assert(check_cache(cache, h0, 0, 0) == 0);
+    assert(check_cache(cache, h0, 0, 3) == 1);
+    mx25519_cache_remove_key(cache, h0);
+    mx25519_pubkey res;
+    assert(mx25519_cache_scmul_key(cache, &res, h0, &cache_peers[3]) == -1);
+    assert(mx25519_cache_add_key(cache, &cache_keys[0]) == h0);
+    assert(check_cache(cache, h0, 0, 3) == 0);
+    mx25519_cache_clear(cache);
+    assert(check_cache(cache, h0, 0, 3) == 0);
+    assert(check_cache(cache, h0, 0, 3) == 1);
+    /* the result may overwrite the peer key */
+    mx25519_pubkey peer = cache_peers[3];
+    assert(mx25519_cache_scmul_key(cache, &peer, h0, &peer) == 1);
+    mx25519_scmul_key(impl, &res, &cache_keys[0], &cache_peers[3]);
+    assert(memcmp(&peer, &res, sizeof(res)) == 0);
+    mx25519_cache_destroy(cache);
+    /* sizes that don't fit the 32-bit shard and entry indices */
+    config.shards = (1u << 31) + 1;
+    assert(mx25519_cache_create(&config) == NULL);
+#if SIZE_MAX > UINT32_MAX
+    config.shards = 1;
+    config.capacity = (size_t)UINT32_MAX + 1;
+    assert(mx25519_cache_create(&config) == NULL);
+#endif
+    return true;
+#else
+    return false;
+#endif
+}
+
+static bool test_cache_threads() {
+#ifdef MX25519_CACHE
+    impl = mx25519_select_impl(MX25519_TYPE_AUTO);
+    assert(impl != NULL);
+    mx25519_cache_config config = { 0 };
+    config.impl = impl;
+    config.capacity = CACHE_TEST_PEERS;
+    config.shards = 4;
+    config.allow_unlocked = 1;
+    mx25519_cache* cache = mx25519_cache_create(&config);
+    assert(cache != NULL);
+    pthread_t threads[CACHE_TEST_THREADS];
+    cache_thread_arg args[CACHE_TEST_THREADS];
+    int h0 = mx25519_cache_add_key(cache, &cache_keys[0]);
+    int h1 = mx25519_cache_add_key(cache, &cache_keys[1]);
+    for (int i = 0; i < CACHE_TEST_THREADS; ++i) {
+        args[i].cache = cache;
+        args[i].handles[0] = h0;
+        args[i].handles[1] = h1;
+        args[i].seed = i;
+        assert(pthread_create(&threads[i], NULL, &cache_thread, &args[i]) == 0);
+    }
+    for (int i = 0; i < CACHE_TEST_THREADS; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+    mx25519_cache_destroy(cache);
+    return true;
+#else
+    return false;
+#endif
+}
+
+static bool test_resumable() {
+    static const unsigned chunks[] = { 0, 1, 7, 64, 255, 1000 };
+    const mx25519_impl* auto_impl = mx25519_select_impl(MX25519_TYPE_AUTO);
+    assert(auto_impl != NULL);
+    for (int i = 0; i < DIFF_TEST_ROUNDS; ++i) {
+        mx25519_privkey key;
+        mx25519_pubkey pt, res1, res2;
+        mx25519_scmul_ctx ctx;
+        unsigned chunk = chunks[i % 6];
+        unsigned remaining = 255;
+        random_bytes(key.data, sizeof(key.data));
+        random_bytes(pt.data, sizeof(pt.data));
+        mx25519_scmul_begin(&ctx, &key, &pt);
+        if (chunk > 0) {
+            while (remaining > 0) {
+                unsigned next = mx25519_scmul_step(&ctx, chunk);
+                assert(next == (remaining > chunk ? remaining - chunk : 0));
+                remaining = next;
+            }
+        }
+        mx25519_scmul_finish(&ctx, &res1);
+        mx25519_scmul_key(auto_impl, &res2, &key, &pt);
+        assert(memcmp(&res1, &res2, sizeof(res1)) == 0);
+    }
+    return true;
+}
+
+/* scalar arithmetic mod l */
+static const char test_scalar_a[] = "f5b165224a58b791df6af1d8303e61cdc4bb86c3d1c427103c344c4189eb2f1e";
+static const char test_scalar_b[] = "7bd5d47e446fcec2a3d811736110e5781bcccea696762e6116c6e9c92d99bf35";
+static const char test_scalar_ab[] = "afcd30c127c57735772df6dfe8563f708d29e300b89718dd42f7a6f010f1de02";
+static const char test_scalar_inv_a[] = "501680373fdf6c857582fc7b884b581a8b85a53639b81d3d68c27f62e13f930d";
+static const char test_scalar_wide[] =
+    "8c2e0718822ce47ca8c74107e66cb0e4b2b3f4d58d82ca6386d2c96e760e819b"
+    "85c924c3597164c4a6058a00581a22b22de50472433d2e44fed8b6b8357e44cd";
+static const char test_scalar_wide_red[] = "fca2a546b749e6dcb82eff2269662539291f324b6218ff1630a00e7db3b9b009";
+static const char test_scalar_one[] = "0100000000000000000000000000000000000000000000000000000000000000";
+static const char test_scalar_zero[] = "0000000000000000000000000000000000000000000000000000000000000000";
+static const char test_base_point[] = "0900000000000000000000000000000000000000000000000000000000000000";
+
+#define SCALAR_TEST_SIZE 70
+
+static bool test_scalar() {
+    mx25519_privkey a, b, r;
+    load_key(a, test_scalar_a);
+    load_key(b, test_scalar_b);
+    mx25519_scalar_mul(&r, &a, &b);
+    assert(equals_hex(r.data, test_scalar_ab));
+    mx25519_scalar_invert(&r, &a);
+    assert(equals_hex(r.data, test_scalar_inv_a));
+    mx25519_scalar_mul(&r, &r, &a);
+    assert(equals_hex(r.data, test_scalar_one));
+    load_key(a, test_scalar_zero);
+    mx25519_scalar_invert(&r, &a);
+    assert(equals_hex(r.data, test_scalar_zero));
+    uint8_t wide[64];
+    hex2bin(test_scalar_wide, 4 * KEY_SIZE, wide);
+    mx25519_scalar_reduce512(&r, wide);
+    assert(equals_hex(r.data, test_scalar_wide_red));
+
+    /* batch inversion matches single inversion, including zeros */
+    mx25519_privkey scalars[SCALAR_TEST_SIZE], inv[SCALAR_TEST_SIZE];
+    random_bytes((uint8_t*)scalars, sizeof(scalars));
+    memset(&scalars[0], 0, sizeof(scalars[0]));
+    memset(&scalars[33], 0, sizeof(scalars[33]));
+    mx25519_scalar_invert_batch(inv, scalars, SCALAR_TEST_SIZE);
+    for (int i = 0; i < SCALAR_TEST_SIZE; ++i) {
+        mx25519_scalar_invert(&r, &scalars[i]);
+        assert(memcmp(&r, &inv[i], sizeof(r)) == 0);
+    }
+    mx25519_scalar_invert_batch(scalars, scalars, SCALAR_TEST_SIZE);
+    assert(memcmp(scalars, inv, sizeof(inv)) == 0);
+
+    /* (1/k)*(k*G) = G */
+    const mx25519_impl* auto_impl = mx25519_select_impl(MX25519_TYPE_AUTO);
+    assert(auto_impl != NULL);
+    mx25519_privkey k, k_inv;
+    mx25519_pubkey pt;
+    random_bytes(wide, sizeof(wide));
+    mx25519_scalar_reduce512(&k, wide);
+    mx25519_scalar_invert(&k_inv, &k);
+    mx25519_scmul_base_unclamped(auto_impl, &pt, &k, MX25519_UNCLAMP_ALL);
+    mx25519_scmul_key_unclamped(auto_impl, &pt, &k_inv, &pt, MX25519_UNCLAMP_ALL);
+    assert(equals_hex(pt.data, test_base_point));
+    return true;
+}
+
+#ifdef HAVE_AMD64_KERNELS
+/* the AMD64X implementation is also available without AVX2 */
+static bool cpu_has_avx2() {
+#if defined(__GNUC__)
+    return __builtin_cpu_supports("avx2");
+#else
+    return true;
+#endif
+}
+#endif
+
+/* compares the AMD64X variant without AVX2 to the AVX2 kernel */
+static bool test_amd64x_gpr() {
+#ifdef HAVE_AMD64_KERNELS
+    if (mx25519_select_impl(MX25519_TYPE_AMD64X) == NULL) {
+        return false;
+    }
+    bool avx2 = cpu_has_avx2();
+    for (int i = 0; i < DIFF_TEST_ROUNDS; ++i) {
+        uint8_t key[32], pt[32], res1[32], res2[32];
+        random_bytes(key, sizeof(key));
+        random_bytes(pt, sizeof(pt));
+        mx25519_scalarmult_amd64x_gpr(res1, key, pt, 248, 64);
+        if (avx2) {
+            mx25519_scalarmult_amd64x(res2, key, pt, 248, 64);
+            assert(memcmp(res1, res2, sizeof(res1)) == 0);
+        }
+        memset(pt, 0, sizeof(pt));
+        pt[0] = 9;
+        mx25519_scalarmult_amd64x_gpr(res1, key, pt, 255, 0);
+        mx25519_scalarmult_amd64x_gpr_base(res2, key, pt, 255, 0);
+        assert(memcmp(res1, res2, sizeof(res1)) == 0);
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef HAVE_PORTABLE_LADDER
+/* the ref10 ladder with one field operation per call, used as a reference
+   for the fused ladder step of the portable implementation */
+static void ladder_portable_ref(uint8_t* xz, const uint8_t* n,
+    const uint8_t* p, uint8_t clamp_lo, uint8_t clamp_hi)
+{
+    uint8_t e[32];
+    fe x1, x2, z2, x3, z3, tmp0, tmp1;
+    unsigned int swap = 0;
+
+    memcpy(e, n, sizeof(e));
+    e[0] &= clamp_lo;
+    e[31] |= clamp_hi;
+    fe_1(x2);
+    fe_0(z2);
+    if (p != NULL) {
+        fe_frombytes(x1, p);
+        fe_copy(x3, x1);
+    }
+    else {
+        fe_0(x3);
+        x3[0] = 9;
+    }
+    fe_1(z3);
+    for (int pos = 254; pos >= 0; --pos) {
+        unsigned int b = (e[pos / 8] >> (pos & 7)) & 1;
+        swap ^= b;
+        fe_cswap(x2, x3, swap);
+        fe_cswap(z2, z3, swap);
+        swap = b;
+        fe_sub(tmp0, x3, z3);
+        fe_sub(tmp1, x2, z2);
+        fe_add(x2, x2, z2);
+        fe_add(z2, x3, z3);
+        fe_mul(z3, tmp0, x2);
+        fe_mul(z2, z2, tmp1);
+        fe_sq(tmp0, tmp1);
+        fe_sq(tmp1, x2);
+        fe_add(x3, z3, z2);
+        fe_sub(z2, z3, z2);
+        fe_mul(x2, tmp1, tmp0);
+        fe_sub(tmp1, tmp1, tmp0);
+        fe_sq(z2, z2);
+        fe_mul121666(z3, tmp1);
+        fe_sq(x3, x3);
+        fe_add(tmp0, tmp0, z3);
+        if (p != NULL) {
+            fe_mul(z3, x1, z2);
+        }
+        else {
+            fe_mul_small(z3, z2, 9);
+        }
+        fe_mul(z2, tmp1, tmp0);
+    }
+    fe_cswap(x2, x3, swap);
+    fe_cswap(z2, z3, swap);
+    fe_tobytes(xz, x2);
+    fe_tobytes(xz + 32, z2);
+    fe_tobytes(xz + 64, x3);
+    fe_tobytes(xz + 96, z3);
+}
+#endif
+
+/* compares the fused portable ladder step with the unfused one, including
+   the base point path, unclamped keys and points >= 2^255-19 */
+static bool test_portable_ladder() {
+#ifdef HAVE_PORTABLE_LADDER
+    static const uint8_t clamps[][2] = { { 248, 64 }, { 255, 0 } };
+    uint8_t key[32], pt[32], res1[128], res2[128];
+    for (int i = 0; i < DIFF_TEST_ROUNDS / 4 + 3; ++i) {
+        random_bytes(key, sizeof(key));
+        switch (i) {
+        case 0:
+            memset(key, 0xff, sizeof(key));
+            memset(pt, 0xff, sizeof(pt));
+            break;
+        case 1:
+            memset(pt, 0, sizeof(pt));
+            break;
+        case 2:
+            hex2bin(test_pt3, 2 * KEY_SIZE, pt);
+            break;
+        default:
+            random_bytes(pt, sizeof(pt));
+            break;
+        }
+        const uint8_t* clamp = clamps[i % 2];
+        mx25519_ladder_portable(res1, key, pt, clamp[0], clamp[1]);
+        ladder_portable_ref(res2, key, pt, clamp[0], clamp[1]);
+        assert(memcmp(res1, res2, sizeof(res1)) == 0);
+        mx25519_ladder_portable(res1, key, NULL, clamp[0], clamp[1]);
+        ladder_portable_ref(res2, key, NULL, clamp[0], clamp[1]);
+        assert(memcmp(res1, res2, sizeof(res1)) == 0);
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+static uint64_t stats_histogram_sum(const mx25519_stats* stats, mx25519_type type) {
+    uint64_t sum = 0;
+    for (int i = 0; i < MX25519_STATS_BUCKETS; ++i) {
+        sum += stats->histogram[type][i];
+    }
+    return sum;
+}
+
+static bool test_stats() {
+    impl = mx25519_select_impl(MX25519_TYPE_AUTO);
+    assert(impl != NULL);
+    mx25519_type type = mx25519_impl_type(impl);
+    mx25519_privkey keys[5];
+    mx25519_pubkey pts[5], res[5];
+    random_bytes((uint8_t*)keys, sizeof(keys));
+    random_bytes((uint8_t*)pts, sizeof(pts));
+    mx25519_stats before, after;
+    mx25519_stats_enable(1);
+    mx25519_stats_snapshot(&before);
+    mx25519_scmul_base(impl, &res[0], &keys[0]);
+    mx25519_scmul_key(impl, &res[0], &keys[0], &pts[0]);
+    mx25519_scmul_key(impl, &res[0], &keys[0], &pts[0]);
+    mx25519_scmul_key_unclamped(impl, &res[0], &keys[0], &pts[0], MX25519_UNCLAMP_ALL);
+    mx25519_scmul_key_batch(impl, res, keys, pts, 5);
+    mx25519_stats_snapshot(&after);
+    assert(after.count[type][MX25519_OP_BASE] - before.count[type][MX25519_OP_BASE] == 1);
+    assert(after.count[type][MX25519_OP_BASE_UNCLAMPED] == before.count[type][MX25519_OP_BASE_UNCLAMPED]);
+    assert(after.count[type][MX25519_OP_KEY] - before.count[type][MX25519_OP_KEY] == 2);
+    assert(after.count[type][MX25519_OP_KEY_UNCLAMPED] - before.count[type][MX25519_OP_KEY_UNCLAMPED] == 1);
+    assert(after.count[type][MX25519_OP_KEY_BATCH] - before.count[type][MX25519_OP_KEY_BATCH] == 5);
+    assert(stats_histogram_sum(&after, type) - stats_histogram_sum(&before, type) == 9);
+    assert(after.ticks[type] > before.ticks[type]);
+    mx25519_stats_enable(0);
+    mx25519_scmul_base(impl, &res[0], &keys[0]);
+    mx25519_stats_snapshot(&before);
+    assert(memcmp(&before, &after, sizeof(before)) == 0);
+    return true;
+}
+
 static bool test_select_auto() {
     impl = mx25519_select_impl(MX25519_TYPE_AUTO);
     assert(impl != NULL);
     mx25519_type type = mx25519_impl_type(impl);
+#ifndef MX25519_FORCE_IMPL_AMD64X_COMPACT
+    /* the compact kernel is only used when requested */
+    assert(type != MX25519_TYPE_AMD64X_COMPACT);
+#endif
+#ifndef MX25519_FORCE_IMPL_ARM64_SVE2
+    assert(type != MX25519_TYPE_ARM64_SVE2);
+#endif
     return true;
 }
 
 static bool test_select_portable() {
     impl = mx25519_select_impl(MX25519_TYPE_PORTABLE);
+#if defined(MX25519_FORCE_IMPL_ARM64) || defined(MX25519_FORCE_IMPL_AMD64) \
+    || defined(MX25519_FORCE_IMPL_AMD64X) || defined(MX25519_FORCE_IMPL_ARM64_MUL64) \
+    || defined(MX25519_FORCE_IMPL_AMD64_MULX) || defined(MX25519_FORCE_IMPL_AMD64X_COMPACT) \
+    || defined(MX25519_FORCE_IMPL_ARM64_SVE2)
+    assert(impl == NULL);
+#else
     assert(impl != NULL);
+#endif
     return true;
 }
 
 static bool test_type_portable() {
+    if (impl == NULL) {
+        return false;
+    }
     mx25519_type type = mx25519_impl_type(impl);
     assert(type == MX25519_TYPE_PORTABLE);
     return true;
 }
 
 static bool test_scmul1_portable() {
+    if (impl == NULL) {
+        return false;
+    }
     assert(check_scmul(rfc7748_sc1, rfc7748_pt1, rfc7748_re1));
     return true;
 }
 
 static bool test_scmul2_portable() {
+    if (impl == NULL) {
+        return false;
+    }
     assert(check_scmul(rfc7748_sc2, rfc7748_pt2, rfc7748_re2));
     return true;
 }
 
 static bool test_scmul3_portable() {
+    if (impl == NULL) {
+        return false;
+    }
     assert(check_scmul(test_sc3, test_pt3, test_re3));
     return true;
 }
 
 static bool test_scmul4_portable() {
+    if (impl == NULL) {
+        return false;
+    }
     assert(check_scmul_unclamped(test_sc4, test_pt4, test_re4, MX25519_UNCLAMP_254));
     return true;
 }
 
 static bool test_dh_portable() {
+    if (impl == NULL) {
+        return false;
+    }
     check_dh();
     return true;
 }
@@ -173,6 +873,46 @@ static bool test_mul_base_times1_portable() {
     return true;
 }
 
+static bool test_base_portable() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_base();
+    return true;
+}
+
+static bool test_full_portable() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_full();
+    return true;
+}
+
+static bool test_batch_portable() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_batch();
+    return true;
+}
+
+static bool test_projective_portable() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_projective();
+    return true;
+}
+
+static bool test_base_and_key_portable() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_base_and_key();
+    return true;
+}
+
 static bool test_select_arm64() {
     impl = mx25519_select_impl(MX25519_TYPE_ARM64);
     return true;
@@ -242,6 +982,54 @@ static bool test_mul_base_times1_arm64() {
     return true;
 }
 
+static bool test_base_arm64() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_base();
+    return true;
+}
+
+static bool test_vs_portable_arm64() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_vs_portable();
+    return true;
+}
+
+static bool test_full_arm64() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_full();
+    return true;
+}
+
+static bool test_batch_arm64() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_batch();
+    return true;
+}
+
+static bool test_projective_arm64() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_projective();
+    return true;
+}
+
+static bool test_base_and_key_arm64() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_base_and_key();
+    return true;
+}
+
 static bool test_select_amd64() {
     impl = mx25519_select_impl(MX25519_TYPE_AMD64);
     return true;
@@ -311,68 +1099,584 @@ static bool test_mul_base_times1_amd64() {
     return true;
 }
 
-static bool test_select_amd64x() {
-    impl = mx25519_select_impl(MX25519_TYPE_AMD64X);
+static bool test_base_amd64() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_base();
     return true;
 }
 
-static bool test_type_amd64x() {
+static bool test_vs_portable_amd64() {
     if (impl == NULL) {
         return false;
     }
-    mx25519_type type = mx25519_impl_type(impl);
-    assert(type == MX25519_TYPE_AMD64X);
+    check_vs_portable();
     return true;
 }
 
-static bool test_scmul1_amd64x() {
+static bool test_full_amd64() {
     if (impl == NULL) {
         return false;
     }
-    assert(check_scmul(rfc7748_sc1, rfc7748_pt1, rfc7748_re1));
+    check_full();
     return true;
 }
 
-static bool test_scmul2_amd64x() {
+static bool test_batch_amd64() {
     if (impl == NULL) {
         return false;
     }
-    assert(check_scmul(rfc7748_sc2, rfc7748_pt2, rfc7748_re2));
+    check_batch();
     return true;
 }
 
-static bool test_scmul3_amd64x() {
+static bool test_projective_amd64() {
     if (impl == NULL) {
         return false;
     }
-    assert(check_scmul(test_sc3, test_pt3, test_re3));
+    check_projective();
     return true;
 }
 
-static bool test_scmul4_amd64x() {
+static bool test_base_and_key_amd64() {
     if (impl == NULL) {
         return false;
     }
-    assert(check_scmul_unclamped(test_sc4, test_pt4, test_re4, MX25519_UNCLAMP_254));
+    check_base_and_key();
     return true;
 }
 
-static bool test_dh_amd64x() {
+static bool test_select_amd64x() {
+    impl = mx25519_select_impl(MX25519_TYPE_AMD64X);
+    return true;
+}
+
+static bool test_type_amd64x() {
     if (impl == NULL) {
         return false;
     }
-    check_dh();
+    mx25519_type type = mx25519_impl_type(impl);
+    assert(type == MX25519_TYPE_AMD64X);
     return true;
 }
 
-static bool test_mul_base_times1_amd64x() {
+static bool test_scmul1_amd64x() {
     if (impl == NULL) {
         return false;
     }
+    assert(check_scmul(rfc7748_sc1, rfc7748_pt1, rfc7748_re1));
+    return true;
+}
 
-    // check that mx25519_scmul_base(1) == B
-    const mx25519_privkey one = {.data = {1}};
-    const mx25519_pubkey B = {.data = {9}};
+static bool test_scmul2_amd64x() {
+    if (impl == NULL) {
+        return false;
+    }
+    assert(check_scmul(rfc7748_sc2, rfc7748_pt2, rfc7748_re2));
+    return true;
+}
+
+static bool test_scmul3_amd64x() {
+    if (impl == NULL) {
+        return false;
+    }
+    assert(check_scmul(test_sc3, test_pt3, test_re3));
+    return true;
+}
+
+static bool test_scmul4_amd64x() {
+    if (impl == NULL) {
+        return false;
+    }
+    assert(check_scmul_unclamped(test_sc4, test_pt4, test_re4, MX25519_UNCLAMP_254));
+    return true;
+}
+
+static bool test_dh_amd64x() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_dh();
+    return true;
+}
+
+static bool test_mul_base_times1_amd64x() {
+    if (impl == NULL) {
+        return false;
+    }
+
+    // check that mx25519_scmul_base(1) == B
+    const mx25519_privkey one = {.data = {1}};
+    const mx25519_pubkey B = {.data = {9}};
+    mx25519_pubkey B1;
+    mx25519_scmul_base_unclamped(impl, &B1, &one, MX25519_UNCLAMP_ALL);
+
+    assert(memcmp(&B1, &B, sizeof(B)) == 0);
+    return true;
+}
+
+static bool test_base_amd64x() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_base();
+    return true;
+}
+
+static bool test_vs_portable_amd64x() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_vs_portable();
+    return true;
+}
+
+static bool test_full_amd64x() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_full();
+    return true;
+}
+
+static bool test_batch_amd64x() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_batch();
+    return true;
+}
+
+static bool test_projective_amd64x() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_projective();
+    return true;
+}
+
+static bool test_base_and_key_amd64x() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_base_and_key();
+    return true;
+}
+
+static bool test_select_arm64_mul64() {
+    impl = mx25519_select_impl(MX25519_TYPE_ARM64_MUL64);
+    return true;
+}
+
+static bool test_type_arm64_mul64() {
+    if (impl == NULL) {
+        return false;
+    }
+    mx25519_type type = mx25519_impl_type(impl);
+    assert(type == MX25519_TYPE_ARM64_MUL64);
+    return true;
+}
+
+static bool test_scmul1_arm64_mul64() {
+    if (impl == NULL) {
+        return false;
+    }
+    assert(check_scmul(rfc7748_sc1, rfc7748_pt1, rfc7748_re1));
+    return true;
+}
+
+static bool test_scmul2_arm64_mul64() {
+    if (impl == NULL) {
+        return false;
+    }
+    assert(check_scmul(rfc7748_sc2, rfc7748_pt2, rfc7748_re2));
+    return true;
+}
+
+static bool test_scmul3_arm64_mul64() {
+    if (impl == NULL) {
+        return false;
+    }
+    assert(check_scmul(test_sc3, test_pt3, test_re3));
+    return true;
+}
+
+static bool test_scmul4_arm64_mul64() {
+    if (impl == NULL) {
+        return false;
+    }
+    assert(check_scmul_unclamped(test_sc4, test_pt4, test_re4, MX25519_UNCLAMP_254));
+    return true;
+}
+
+static bool test_dh_arm64_mul64() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_dh();
+    return true;
+}
+
+static bool test_mul_base_times1_arm64_mul64() {
+    if (impl == NULL) {
+        return false;
+    }
+
+    // check that mx25519_scmul_base(1) == B
+    const mx25519_privkey one = {.data = {1}};
+    const mx25519_pubkey B = {.data = {9}};
+    mx25519_pubkey B1;
+    mx25519_scmul_base_unclamped(impl, &B1, &one, MX25519_UNCLAMP_ALL);
+
+    assert(memcmp(&B1, &B, sizeof(B)) == 0);
+    return true;
+}
+
+static bool test_base_arm64_mul64() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_base();
+    return true;
+}
+
+static bool test_vs_portable_arm64_mul64() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_vs_portable();
+    return true;
+}
+
+static bool test_full_arm64_mul64() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_full();
+    return true;
+}
+
+static bool test_batch_arm64_mul64() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_batch();
+    return true;
+}
+
+static bool test_projective_arm64_mul64() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_projective();
+    return true;
+}
+
+static bool test_base_and_key_arm64_mul64() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_base_and_key();
+    return true;
+}
+
+static bool test_select_amd64_mulx() {
+    impl = mx25519_select_impl(MX25519_TYPE_AMD64_MULX);
+    return true;
+}
+
+static bool test_type_amd64_mulx() {
+    if (impl == NULL) {
+        return false;
+    }
+    mx25519_type type = mx25519_impl_type(impl);
+    assert(type == MX25519_TYPE_AMD64_MULX);
+    return true;
+}
+
+static bool test_scmul1_amd64_mulx() {
+    if (impl == NULL) {
+        return false;
+    }
+    assert(check_scmul(rfc7748_sc1, rfc7748_pt1, rfc7748_re1));
+    return true;
+}
+
+static bool test_scmul2_amd64_mulx() {
+    if (impl == NULL) {
+        return false;
+    }
+    assert(check_scmul(rfc7748_sc2, rfc7748_pt2, rfc7748_re2));
+    return true;
+}
+
+static bool test_scmul3_amd64_mulx() {
+    if (impl == NULL) {
+        return false;
+    }
+    assert(check_scmul(test_sc3, test_pt3, test_re3));
+    return true;
+}
+
+static bool test_scmul4_amd64_mulx() {
+    if (impl == NULL) {
+        return false;
+    }
+    assert(check_scmul_unclamped(test_sc4, test_pt4, test_re4, MX25519_UNCLAMP_254));
+    return true;
+}
+
+static bool test_dh_amd64_mulx() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_dh();
+    return true;
+}
+
+static bool test_mul_base_times1_amd64_mulx() {
+    if (impl == NULL) {
+        return false;
+    }
+
+    // check that mx25519_scmul_base(1) == B
+    const mx25519_privkey one = {.data = {1}};
+    const mx25519_pubkey B = {.data = {9}};
+    mx25519_pubkey B1;
+    mx25519_scmul_base_unclamped(impl, &B1, &one, MX25519_UNCLAMP_ALL);
+
+    assert(memcmp(&B1, &B, sizeof(B)) == 0);
+    return true;
+}
+
+static bool test_base_amd64_mulx() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_base();
+    return true;
+}
+
+static bool test_vs_portable_amd64_mulx() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_vs_portable();
+    return true;
+}
+
+static bool test_full_amd64_mulx() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_full();
+    return true;
+}
+
+static bool test_batch_amd64_mulx() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_batch();
+    return true;
+}
+
+static bool test_projective_amd64_mulx() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_projective();
+    return true;
+}
+
+static bool test_base_and_key_amd64_mulx() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_base_and_key();
+    return true;
+}
+
+static bool test_select_amd64x_compact() {
+    impl = mx25519_select_impl(MX25519_TYPE_AMD64X_COMPACT);
+    return true;
+}
+
+static bool test_type_amd64x_compact() {
+    if (impl == NULL) {
+        return false;
+    }
+    mx25519_type type = mx25519_impl_type(impl);
+    assert(type == MX25519_TYPE_AMD64X_COMPACT);
+    return true;
+}
+
+static bool test_scmul1_amd64x_compact() {
+    if (impl == NULL) {
+        return false;
+    }
+    assert(check_scmul(rfc7748_sc1, rfc7748_pt1, rfc7748_re1));
+    return true;
+}
+
+static bool test_scmul2_amd64x_compact() {
+    if (impl == NULL) {
+        return false;
+    }
+    assert(check_scmul(rfc7748_sc2, rfc7748_pt2, rfc7748_re2));
+    return true;
+}
+
+static bool test_scmul3_amd64x_compact() {
+    if (impl == NULL) {
+        return false;
+    }
+    assert(check_scmul(test_sc3, test_pt3, test_re3));
+    return true;
+}
+
+static bool test_scmul4_amd64x_compact() {
+    if (impl == NULL) {
+        return false;
+    }
+    assert(check_scmul_unclamped(test_sc4, test_pt4, test_re4, MX25519_UNCLAMP_254));
+    return true;
+}
+
+static bool test_dh_amd64x_compact() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_dh();
+    return true;
+}
+
+static bool test_mul_base_times1_amd64x_compact() {
+    if (impl == NULL) {
+        return false;
+    }
+
+    // check that mx25519_scmul_base(1) == B
+    const mx25519_privkey one = {.data = {1}};
+    const mx25519_pubkey B = {.data = {9}};
+    mx25519_pubkey B1;
+    mx25519_scmul_base_unclamped(impl, &B1, &one, MX25519_UNCLAMP_ALL);
+
+    assert(memcmp(&B1, &B, sizeof(B)) == 0);
+    return true;
+}
+
+static bool test_base_amd64x_compact() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_base();
+    return true;
+}
+
+static bool test_vs_portable_amd64x_compact() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_vs_portable();
+    return true;
+}
+
+static bool test_full_amd64x_compact() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_full();
+    return true;
+}
+
+static bool test_batch_amd64x_compact() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_batch();
+    return true;
+}
+
+static bool test_projective_amd64x_compact() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_projective();
+    return true;
+}
+
+static bool test_base_and_key_amd64x_compact() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_base_and_key();
+    return true;
+}
+
+static bool test_select_arm64_sve2() {
+    impl = mx25519_select_impl(MX25519_TYPE_ARM64_SVE2);
+    return true;
+}
+
+static bool test_type_arm64_sve2() {
+    if (impl == NULL) {
+        return false;
+    }
+    mx25519_type type = mx25519_impl_type(impl);
+    assert(type == MX25519_TYPE_ARM64_SVE2);
+    return true;
+}
+
+static bool test_scmul1_arm64_sve2() {
+    if (impl == NULL) {
+        return false;
+    }
+    assert(check_scmul(rfc7748_sc1, rfc7748_pt1, rfc7748_re1));
+    return true;
+}
+
+static bool test_scmul2_arm64_sve2() {
+    if (impl == NULL) {
+        return false;
+    }
+    assert(check_scmul(rfc7748_sc2, rfc7748_pt2, rfc7748_re2));
+    return true;
+}
+
+static bool test_scmul3_arm64_sve2() {
+    if (impl == NULL) {
+        return false;
+    }
+    assert(check_scmul(test_sc3, test_pt3, test_re3));
+    return true;
+}
+
+static bool test_scmul4_arm64_sve2() {
+    if (impl == NULL) {
+        return false;
+    }
+    assert(check_scmul_unclamped(test_sc4, test_pt4, test_re4, MX25519_UNCLAMP_254));
+    return true;
+}
+
+static bool test_dh_arm64_sve2() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_dh();
+    return true;
+}
+
+static bool test_mul_base_times1_arm64_sve2() {
+    if (impl == NULL) {
+        return false;
+    }
+
+    // check that mx25519_scmul_base(1) == B
+    const mx25519_privkey one = {.data = {1}};
+    const mx25519_pubkey B = {.data = {9}};
     mx25519_pubkey B1;
     mx25519_scmul_base_unclamped(impl, &B1, &one, MX25519_UNCLAMP_ALL);
 
@@ -380,6 +1684,54 @@ static bool test_mul_base_times1_amd64x() {
     return true;
 }
 
+static bool test_base_arm64_sve2() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_base();
+    return true;
+}
+
+static bool test_vs_portable_arm64_sve2() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_vs_portable();
+    return true;
+}
+
+static bool test_full_arm64_sve2() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_full();
+    return true;
+}
+
+static bool test_batch_arm64_sve2() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_batch();
+    return true;
+}
+
+static bool test_projective_arm64_sve2() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_projective();
+    return true;
+}
+
+static bool test_base_and_key_arm64_sve2() {
+    if (impl == NULL) {
+        return false;
+    }
+    check_base_and_key();
+    return true;
+}
+
 int main() {
     RUN_TEST(test_select_auto);
     RUN_TEST(test_select_portable);
@@ -390,6 +1742,11 @@ int main() {
     RUN_TEST(test_scmul4_portable);
     RUN_TEST(test_dh_portable);
     RUN_TEST(test_mul_base_times1_portable);
+    RUN_TEST(test_base_portable);
+    RUN_TEST(test_full_portable);
+    RUN_TEST(test_batch_portable);
+    RUN_TEST(test_projective_portable);
+    RUN_TEST(test_base_and_key_portable);
     RUN_TEST(test_select_arm64);
     RUN_TEST(test_type_arm64);
     RUN_TEST(test_scmul1_arm64);
@@ -398,6 +1755,12 @@ int main() {
     RUN_TEST(test_scmul4_arm64);
     RUN_TEST(test_dh_arm64);
     RUN_TEST(test_mul_base_times1_arm64);
+    RUN_TEST(test_base_arm64);
+    RUN_TEST(test_full_arm64);
+    RUN_TEST(test_batch_arm64);
+    RUN_TEST(test_projective_arm64);
+    RUN_TEST(test_base_and_key_arm64);
+    RUN_TEST(test_vs_portable_arm64);
     RUN_TEST(test_select_amd64);
     RUN_TEST(test_type_amd64);
     RUN_TEST(test_scmul1_amd64);
@@ -406,6 +1769,12 @@ int main() {
     RUN_TEST(test_scmul4_amd64);
     RUN_TEST(test_dh_amd64);
     RUN_TEST(test_mul_base_times1_amd64);
+    RUN_TEST(test_base_amd64);
+    RUN_TEST(test_full_amd64);
+    RUN_TEST(test_batch_amd64);
+    RUN_TEST(test_projective_amd64);
+    RUN_TEST(test_base_and_key_amd64);
+    RUN_TEST(test_vs_portable_amd64);
     RUN_TEST(test_select_amd64x);
     RUN_TEST(test_type_amd64x);
     RUN_TEST(test_scmul1_amd64x);
@@ -414,6 +1783,77 @@ int main() {
     RUN_TEST(test_scmul4_amd64x);
     RUN_TEST(test_dh_amd64x);
     RUN_TEST(test_mul_base_times1_amd64x);
+    RUN_TEST(test_base_amd64x);
+    RUN_TEST(test_full_amd64x);
+    RUN_TEST(test_batch_amd64x);
+    RUN_TEST(test_projective_amd64x);
+    RUN_TEST(test_base_and_key_amd64x);
+    RUN_TEST(test_vs_portable_amd64x);
+    RUN_TEST(test_select_arm64_mul64);
+    RUN_TEST(test_type_arm64_mul64);
+    RUN_TEST(test_scmul1_arm64_mul64);
+    RUN_TEST(test_scmul2_arm64_mul64);
+    RUN_TEST(test_scmul3_arm64_mul64);
+    RUN_TEST(test_scmul4_arm64_mul64);
+    RUN_TEST(test_dh_arm64_mul64);
+    RUN_TEST(test_mul_base_times1_arm64_mul64);
+    RUN_TEST(test_base_arm64_mul64);
+    RUN_TEST(test_full_arm64_mul64);
+    RUN_TEST(test_batch_arm64_mul64);
+    RUN_TEST(test_projective_arm64_mul64);
+    RUN_TEST(test_base_and_key_arm64_mul64);
+    RUN_TEST(test_vs_portable_arm64_mul64);
+    RUN_TEST(test_select_amd64_mulx);
+    RUN_TEST(test_type_amd64_mulx);
+    RUN_TEST(test_scmul1_amd64_mulx);
+    RUN_TEST(test_scmul2_amd64_mulx);
+    RUN_TEST(test_scmul3_amd64_mulx);
+    RUN_TEST(test_scmul4_amd64_mulx);
+    RUN_TEST(test_dh_amd64_mulx);
+    RUN_TEST(test_mul_base_times1_amd64_mulx);
+    RUN_TEST(test_base_amd64_mulx);
+    RUN_TEST(test_full_amd64_mulx);
+    RUN_TEST(test_batch_amd64_mulx);
+    RUN_TEST(test_projective_amd64_mulx);
+    RUN_TEST(test_base_and_key_amd64_mulx);
+    RUN_TEST(test_vs_portable_amd64_mulx);
+    RUN_TEST(test_select_amd64x_compact);
+    RUN_TEST(test_type_amd64x_compact);
+    RUN_TEST(test_scmul1_amd64x_compact);
+    RUN_TEST(test_scmul2_amd64x_compact);
+    RUN_TEST(test_scmul3_amd64x_compact);
+    RUN_TEST(test_scmul4_amd64x_compact);
+    RUN_TEST(test_dh_amd64x_compact);
+    RUN_TEST(test_mul_base_times1_amd64x_compact);
+    RUN_TEST(test_base_amd64x_compact);
+    RUN_TEST(test_full_amd64x_compact);
+    RUN_TEST(test_batch_amd64x_compact);
+    RUN_TEST(test_projective_amd64x_compact);
+    RUN_TEST(test_base_and_key_amd64x_compact);
+    RUN_TEST(test_vs_portable_amd64x_compact);
+    RUN_TEST(test_select_arm64_sve2);
+    RUN_TEST(test_type_arm64_sve2);
+    RUN_TEST(test_scmul1_arm64_sve2);
+    RUN_TEST(test_scmul2_arm64_sve2);
+    RUN_TEST(test_scmul3_arm64_sve2);
+    RUN_TEST(test_scmul4_arm64_sve2);
+    RUN_TEST(test_dh_arm64_sve2);
+    RUN_TEST(test_mul_base_times1_arm64_sve2);
+    RUN_TEST(test_base_arm64_sve2);
+    RUN_TEST(test_full_arm64_sve2);
+    RUN_TEST(test_batch_arm64_sve2);
+    RUN_TEST(test_projective_arm64_sve2);
+    RUN_TEST(test_base_and_key_arm64_sve2);
+    RUN_TEST(test_vs_portable_arm64_sve2);
+    RUN_TEST(test_amd64x_gpr);
+    RUN_TEST(test_portable_ladder);
+    RUN_TEST(test_async_callback);
+    RUN_TEST(test_async_ring);
+    RUN_TEST(test_cache);
+    RUN_TEST(test_cache_threads);
+    RUN_TEST(test_stats);
+    RUN_TEST(test_scalar);
+    RUN_TEST(test_resumable);
 
     printf("\nAll tests were successful\n");
     return 0;
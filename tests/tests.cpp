@@ -0,0 +1,167 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <mx25519.hpp>
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+static int test_no = 0;
+
+#define RUN_TEST(x) run_test(#x, &x)
+
+static void run_test(const char* name, bool (*func)()) {
+    std::printf("[%2i] %-40s ... ", ++test_no, name);
+    std::printf(func() ? "PASSED\n" : "SKIPPED\n");
+}
+
+/* RFC 7748 DH test vectors */
+static constexpr std::array<std::uint8_t, 32> alice_priv = {
+    0x77, 0x07, 0x6d, 0x0a, 0x73, 0x18, 0xa5, 0x7d, 0x3c, 0x16, 0xc1, 0x72, 0x51, 0xb2, 0x66, 0x45,
+    0xdf, 0x4c, 0x2f, 0x87, 0xeb, 0xc0, 0x99, 0x2a, 0xb1, 0x77, 0xfb, 0xa5, 0x1d, 0xb9, 0x2c, 0x2a };
+static constexpr std::array<std::uint8_t, 32> alice_pub = {
+    0x85, 0x20, 0xf0, 0x09, 0x89, 0x30, 0xa7, 0x54, 0x74, 0x8b, 0x7d, 0xdc, 0xb4, 0x3e, 0xf7, 0x5a,
+    0x0d, 0xbf, 0x3a, 0x0d, 0x26, 0x38, 0x1a, 0xf4, 0xeb, 0xa4, 0xa9, 0x8e, 0xaa, 0x9b, 0x4e, 0x6a };
+static constexpr std::array<std::uint8_t, 32> bob_pub = {
+    0xde, 0x9e, 0xdb, 0x7d, 0x7b, 0x7d, 0xc1, 0xb4, 0xd3, 0x5b, 0x61, 0xc2, 0xec, 0xe4, 0x35, 0x37,
+    0x3f, 0x83, 0x43, 0xc8, 0x5b, 0x78, 0x67, 0x4d, 0xad, 0xfc, 0x7e, 0x14, 0x6f, 0x88, 0x2b, 0x4f };
+static constexpr std::array<std::uint8_t, 32> shared = {
+    0x4a, 0x5d, 0x9d, 0x5b, 0xa4, 0xce, 0x2d, 0xe1, 0x72, 0x8e, 0x3b, 0xf4, 0x80, 0x35, 0x0f, 0x25,
+    0xe0, 0x7e, 0x21, 0xc9, 0x47, 0xd1, 0x9e, 0x33, 0x76, 0xf0, 0x9b, 0x3c, 0x1e, 0x16, 0x17, 0x42 };
+
+#define BATCH_TEST_SIZE 100
+
+static std::uint64_t rng_state = 0x9e3779b97f4a7c15;
+
+static void random_bytes(std::span<std::uint8_t> out) {
+    for (auto& b : out) {
+        /* xorshift64 */
+        rng_state ^= rng_state << 13;
+        rng_state ^= rng_state >> 7;
+        rng_state ^= rng_state << 17;
+        b = static_cast<std::uint8_t>(rng_state);
+    }
+}
+
+template<class Engine>
+static bool check_engine() {
+    if (!Engine::supported()) {
+        return false;
+    }
+    mx25519::privkey priv(alice_priv);
+    assert(Engine::scmul_base(priv) == mx25519::pubkey(alice_pub));
+    assert(Engine::scmul_key(priv, mx25519::pubkey(bob_pub)) == mx25519::pubkey(shared));
+    mx25519::point full = Engine::scmul_base_full(priv);
+    assert(std::equal(alice_pub.begin(), alice_pub.end(), full.u));
+    auto [pub, sh] = Engine::scmul_base_and_key(priv, mx25519::pubkey(bob_pub));
+    assert(pub == mx25519::pubkey(alice_pub));
+    assert(sh == mx25519::pubkey(shared));
+
+    std::vector<mx25519::privkey> keys(BATCH_TEST_SIZE);
+    std::vector<mx25519::pubkey> points(BATCH_TEST_SIZE);
+    std::vector<mx25519::pubkey> results(BATCH_TEST_SIZE);
+    for (std::size_t i = 0; i < BATCH_TEST_SIZE; ++i) {
+        random_bytes(keys[i].bytes());
+        random_bytes(points[i].bytes());
+    }
+    Engine::scmul_key(results, keys, points);
+    for (std::size_t i = 0; i < BATCH_TEST_SIZE; ++i) {
+        assert(results[i] == Engine::scmul_key(keys[i], points[i]));
+    }
+    Engine::scmul_base(results, keys);
+    for (std::size_t i = 0; i < BATCH_TEST_SIZE; ++i) {
+        assert(results[i] == Engine::scmul_base(keys[i]));
+    }
+#ifdef MX25519_HAS_EXECUTION
+    std::vector<mx25519::pubkey> results_par(BATCH_TEST_SIZE);
+    Engine::scmul_key(std::execution::par, results_par, keys, points);
+    Engine::scmul_key(results, keys, points);
+    assert(results_par == results);
+    Engine::scmul_base(std::execution::par, results_par, keys);
+    Engine::scmul_base(results, keys);
+    assert(results_par == results);
+    static_assert(!requires {
+        Engine::scmul_base(std::execution::par_unseq, results_par, keys);
+    });
+#endif
+    bool thrown = false;
+    try {
+        Engine::scmul_key(std::span(results).first(1), keys, points);
+    }
+    catch (const std::length_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    return true;
+}
+
+static bool test_engine_auto() {
+    assert(mx25519::auto_engine::supported());
+    assert(mx25519::auto_engine::impl_type() != mx25519::type::autodetect);
+#ifdef MX25519_FORCE_IMPL
+    assert(mx25519::auto_engine::impl() == &mx25519_impl_forced);
+#endif
+    return check_engine<mx25519::auto_engine>();
+}
+
+static bool test_engine_portable() {
+    if (!mx25519::portable_engine::supported()) {
+        return false;
+    }
+    assert(mx25519::portable_engine::impl_type() == mx25519::type::portable);
+    return check_engine<mx25519::portable_engine>();
+}
+
+static bool test_engine_arm64() {
+    return check_engine<mx25519::arm64_engine>();
+}
+
+static bool test_engine_amd64() {
+    return check_engine<mx25519::amd64_engine>();
+}
+
+static bool test_engine_amd64x() {
+    return check_engine<mx25519::amd64x_engine>();
+}
+
+static bool test_engine_arm64_mul64() {
+    return check_engine<mx25519::arm64_mul64_engine>();
+}
+
+static bool test_engine_amd64_mulx() {
+    return check_engine<mx25519::amd64_mulx_engine>();
+}
+
+static bool test_engine_amd64x_compact() {
+    return check_engine<mx25519::amd64x_compact_engine>();
+}
+
+static bool test_engine_arm64_sve2() {
+    return check_engine<mx25519::arm64_sve2_engine>();
+}
+
+int main() {
+    RUN_TEST(test_engine_auto);
+    RUN_TEST(test_engine_portable);
+    RUN_TEST(test_engine_arm64);
+    RUN_TEST(test_engine_amd64);
+    RUN_TEST(test_engine_amd64x);
+    RUN_TEST(test_engine_arm64_mul64);
+    RUN_TEST(test_engine_amd64_mulx);
+    RUN_TEST(test_engine_amd64x_compact);
+    RUN_TEST(test_engine_arm64_sve2);
+
+    std::printf("\nAll tests were successful\n");
+    return 0;
+}
@@ -0,0 +1,360 @@
+/* Copyright (c) 2026 tevador <tevador@gmail.com>
+ *
+ * This file is part of mx25519, which is released under LGPLv3.
+ * See LICENSE for full license details.
+*/
+
+/*
+ * Bulk scalar multiplication over memory-mapped files of packed 32-byte
+ * keys. Results are written directly into the memory-mapped output file.
+ *
+ * mx25519-scan [options] -k KEYS -o OUT            out[i] = x(k[i]*G)
+ * mx25519-scan [options] -k KEYS -p POINTS -o OUT  out[j*M+i] = x(k[j]*P[i])
+ * mx25519-scan [options] -z -k KEYS -p POINTS -o OUT  out[i] = x(k[i]*P[i])
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <mx25519.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define KEY_SIZE 32
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+/* keys per call of mx25519_scmul_key_batch */
+#define SCAN_BATCH 64
+
+/* keys per work unit taken by a thread */
+#define SCAN_CHUNK (16 * SCAN_BATCH)
+
+typedef enum scan_mode {
+    SCAN_BASE,   /* x(k[i]*G) */
+    SCAN_CROSS,  /* x(k[j]*P[i]) for all pairs */
+    SCAN_PAIRED, /* x(k[i]*P[i]) */
+} scan_mode;
+
+typedef struct scan_file {
+    void* data;
+    size_t size;
+} scan_file;
+
+typedef struct scan_job {
+    const mx25519_impl* impl;
+    scan_mode mode;
+    const mx25519_privkey* keys;
+    const mx25519_pubkey* points;
+    mx25519_pubkey* results;
+    size_t num_keys;
+    size_t num_points; /* results per private key */
+    size_t units_per_key;
+    size_t units;
+    size_t next_unit; /* atomic */
+} scan_job;
+
+/* indexed by mx25519_type + 1 */
+static const char* impl_names[MX25519_TYPE_COUNT + 1] = {
+    "auto", "portable", "arm64", "amd64", "amd64x", "arm64-mul64",
+    "amd64-mulx", "amd64x-compact", "arm64-sve2"
+};
+
+static void usage(const char* prog) {
+    fprintf(stderr,
+        "Usage: %s [-t THREADS] [-i IMPL] [-z] -k KEYS [-p POINTS] -o OUT\n"
+        "  -k KEYS    file of packed 32-byte private keys\n"
+        "  -p POINTS  file of packed 32-byte public keys; if omitted, the\n"
+        "             public keys of KEYS are calculated\n"
+        "  -o OUT     output file, overwritten\n"
+        "  -z         pair KEYS and POINTS instead of using all combinations\n"
+        "  -t THREADS number of threads (default: all cores)\n"
+        "  -i IMPL    auto, portable, arm64, amd64, amd64x, arm64-mul64,\n"
+        "             amd64-mulx, amd64x-compact or arm64-sve2 (default: auto)\n",
+        prog);
+}
+
+static void map_advise(void* data, size_t size, int advice) {
+#ifdef MADV_HUGEPAGE
+    madvise(data, size, MADV_HUGEPAGE);
+#endif
+    madvise(data, size, advice);
+}
+
+static bool map_input(const char* path, scan_file* file) {
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return false;
+    }
+    if (fstat(fd, &st) != 0) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        close(fd);
+        return false;
+    }
+    file->size = (size_t)st.st_size;
+    if (file->size == 0 || file->size % KEY_SIZE != 0) {
+        fprintf(stderr, "%s: size is not a positive multiple of %d\n",
+            path, KEY_SIZE);
+        close(fd);
+        return false;
+    }
+    file->data = mmap(NULL, file->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (file->data == MAP_FAILED) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return false;
+    }
+    map_advise(file->data, file->size, MADV_SEQUENTIAL);
+    return true;
+}
+
+static bool map_output(const char* path, size_t size, scan_file* file) {
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return false;
+    }
+    if (ftruncate(fd, (off_t)size) != 0) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        close(fd);
+        return false;
+    }
+    file->size = size;
+    file->data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (file->data == MAP_FAILED) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return false;
+    }
+    map_advise(file->data, file->size, MADV_SEQUENTIAL);
+    return true;
+}
+
+static void* scan_worker(void* arg) {
+    scan_job* job = arg;
+    mx25519_privkey key_buf[SCAN_BATCH];
+    mx25519_pubkey base_buf[SCAN_BATCH];
+    const mx25519_privkey* keys;
+    const mx25519_pubkey* points;
+    size_t unit, j, first, end, count, i;
+
+    /* buffers are filled once per unit, not per record */
+    memset(base_buf, 0, sizeof(base_buf));
+    for (i = 0; i < SCAN_BATCH; ++i) {
+        base_buf[i].data[0] = 9;
+    }
+
+    for (;;) {
+        unit = __atomic_fetch_add(&job->next_unit, 1, __ATOMIC_RELAXED);
+        if (unit >= job->units) {
+            break;
+        }
+        j = unit / job->units_per_key;
+        first = (unit % job->units_per_key) * SCAN_CHUNK;
+        end = job->num_points;
+        if (end > first + SCAN_CHUNK) {
+            end = first + SCAN_CHUNK;
+        }
+        if (job->mode == SCAN_CROSS) {
+            for (i = 0; i < SCAN_BATCH; ++i) {
+                key_buf[i] = job->keys[j];
+            }
+        }
+        for (; first < end; first += count) {
+            count = end - first < SCAN_BATCH ? end - first : SCAN_BATCH;
+            switch (job->mode) {
+            case SCAN_BASE:
+                keys = &job->keys[first];
+                points = base_buf;
+                break;
+            case SCAN_CROSS:
+                keys = key_buf;
+                points = &job->points[first];
+                break;
+            default:
+                keys = &job->keys[first];
+                points = &job->points[first];
+                break;
+            }
+            mx25519_scmul_key_batch(job->impl,
+                &job->results[j * job->num_points + first],
+                keys, points, count);
+        }
+    }
+    if (job->mode == SCAN_CROSS) {
+        memset(key_buf, 0, sizeof(key_buf));
+    }
+    return NULL;
+}
+
+static double clock_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char** argv) {
+    const char* keys_path = NULL;
+    const char* points_path = NULL;
+    const char* out_path = NULL;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    mx25519_type type = MX25519_TYPE_AUTO;
+    bool paired = false;
+    scan_file keys_file, points_file = { NULL, 0 }, out_file;
+    scan_job job;
+    pthread_t* tids;
+    size_t out_count, in_bytes;
+    double start, elapsed;
+    long t;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "k:p:o:zt:i:h")) != -1) {
+        switch (opt) {
+        case 'k':
+            keys_path = optarg;
+            break;
+        case 'p':
+            points_path = optarg;
+            break;
+        case 'o':
+            out_path = optarg;
+            break;
+        case 'z':
+            paired = true;
+            break;
+        case 't':
+            threads = strtol(optarg, NULL, 10);
+            break;
+        case 'i':
+            for (t = 0; t < (long)ARRAY_SIZE(impl_names); ++t) {
+                if (strcmp(optarg, impl_names[t]) == 0) {
+                    break;
+                }
+            }
+            if (t == (long)ARRAY_SIZE(impl_names)) {
+                usage(argv[0]);
+                return 1;
+            }
+            type = (mx25519_type)(t - 1);
+            break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (keys_path == NULL || out_path == NULL || threads < 1
+        || (paired && points_path == NULL))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    memset(&job, 0, sizeof(job));
+    job.impl = mx25519_select_impl(type);
+    if (job.impl == NULL) {
+        fprintf(stderr, "Implementation '%s' is not supported\n",
+            impl_names[type + 1]);
+        return 1;
+    }
+    if (!map_input(keys_path, &keys_file)) {
+        return 1;
+    }
+    job.keys = keys_file.data;
+    job.num_keys = keys_file.size / KEY_SIZE;
+    in_bytes = keys_file.size;
+
+    if (points_path == NULL) {
+        job.mode = SCAN_BASE;
+        out_count = job.num_keys;
+    }
+    else {
+        if (!map_input(points_path, &points_file)) {
+            return 1;
+        }
+        job.points = points_file.data;
+        job.num_points = points_file.size / KEY_SIZE;
+        in_bytes += points_file.size;
+        if (paired) {
+            if (job.num_points != job.num_keys) {
+                fprintf(stderr, "%s and %s have a different number of keys\n",
+                    keys_path, points_path);
+                return 1;
+            }
+            job.mode = SCAN_PAIRED;
+            out_count = job.num_keys;
+        }
+        else {
+            if (job.num_points > SIZE_MAX / KEY_SIZE / job.num_keys) {
+                fprintf(stderr, "Output is too large\n");
+                return 1;
+            }
+            job.mode = SCAN_CROSS;
+            out_count = job.num_keys * job.num_points;
+        }
+    }
+
+    if (!map_output(out_path, out_count * KEY_SIZE, &out_file)) {
+        return 1;
+    }
+    job.results = out_file.data;
+
+    /* work units never span two private keys in SCAN_CROSS mode,
+       the other modes behave like a single key with j = 0 */
+    if (job.mode != SCAN_CROSS) {
+        job.num_points = out_count;
+    }
+    job.units_per_key = (job.num_points + SCAN_CHUNK - 1) / SCAN_CHUNK;
+    job.units = job.units_per_key * (job.mode == SCAN_CROSS ? job.num_keys : 1);
+    if ((size_t)threads > job.units) {
+        threads = (long)job.units;
+    }
+
+    tids = malloc(threads * sizeof(pthread_t));
+    if (tids == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    start = clock_seconds();
+    for (t = 0; t < threads; ++t) {
+        if (pthread_create(&tids[t], NULL, &scan_worker, &job) != 0) {
+            fprintf(stderr, "Failed to start thread %ld\n", t);
+            return 1;
+        }
+    }
+    for (t = 0; t < threads; ++t) {
+        pthread_join(tids[t], NULL);
+    }
+    elapsed = clock_seconds() - start;
+    free(tids);
+
+    if (msync(out_file.data, out_file.size, MS_SYNC) != 0) {
+        fprintf(stderr, "%s: %s\n", out_path, strerror(errno));
+        return 1;
+    }
+    munmap(out_file.data, out_file.size);
+    munmap(keys_file.data, keys_file.size);
+    if (points_file.data != NULL) {
+        munmap(points_file.data, points_file.size);
+    }
+
+    fprintf(stderr, "%zu results in %.3f s using %ld thread(s), impl %s\n",
+        out_count, elapsed, threads,
+        impl_names[mx25519_impl_type(job.impl) + 1]);
+    fprintf(stderr, "%.0f ops/s, %.3f GB/s\n", out_count / elapsed,
+        (in_bytes + out_count * KEY_SIZE) / elapsed * 1e-9);
+    return 0;
+}